@@ -0,0 +1,17 @@
+/*
+	Benchmark build configuration.
+	Uncomment the oop.h defines to benchmark, oop_bench.sqf reports the active ones.
+*/
+
+// #define OOP_TABLE_DISPATCH
+// #define OOP_HANDLES
+// #define OOP_HASHMAP_STORAGE
+// #define OOP_AUTO_CLEANUP
+// #define OOP_RECYCLE_IDS
+// #define OOP_RELEASE
+// #define OOP_CLASS_STORAGE
+// #define OOP_DELETE_DEFERRED
+// #define OOP_REGISTRY
+// #define OOP_SERIALIZE
+// #define OOP_REPLICATION
+// #define OOP_PROFILE
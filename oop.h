@@ -35,7 +35,40 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #define CONSTRUCTOR_METHOD "constructor"
 #define DECONSTRUCTOR_METHOD "deconstructor"
+#define DELETE_METHOD "#delete"
+#define RELEASE_METHOD "#release"
+#define RETAIN_METHOD "#retain"
+#define WEAK_METHOD "#weak"
+#define DELETE_DEFERRED_METHOD "#deleteDeferred"
+#define REAP_METHOD "#reap"
+#define REFS_VAR "#refs"
+#define RESET_METHOD "reset"
+#define SCHEMA_METHOD "#schema"
+#define SERIALIZE_METHOD "#serialize"
+#define REPLICATED_METHOD "#replicated"
+#define SCHEMA_VERSION_METHOD "schemaVersion"
+#define RESTORED_METHOD "restored"
 #define AUTO_INC_VAR(className) (className + "_IDAI")
+#define FREE_IDS_VAR(className) (className + "_#IDFREE")
+#define TRACK_VAR(classID) (classID + "_#vars")
+#define CLASS_STORE_VAR(className) (className + "_#STORE")
+#define SCHEMA_VAR(className) (className + "_#SCHEMA")
+#define OWNVARS_VAR(className) (className + "_#OWNVARS")
+#define OWNREP_VAR(className) (className + "_#OWNREP")
+#define REPNAMES_VAR(className) (className + "_#REPNAMES")
+#define POOL_VAR(className) (className + "_#POOL")
+#define POOL_FREE_VAR(className) (className + "_#POOLFREE")
+#define POOL_STATS_VAR(className) (className + "_#POOLSTATS")
+#define BULK_VAR(className) (className + "_#BULK")
+#define REGISTRY_VAR(className) (className + "_#REG")
+#define WEAK_VAR "OOP_WEAK"
+#define WEAK_SEQ_VAR "OOP_WEAK_SEQ"
+#define DEAD_VAR "OOP_DEAD"
+#define EVENTS_VAR "OOP_EVENTS"
+#define CLASSES_VAR "OOP_CLASSES"
+#define EVENT_SUBS_VAR "OOP_EVENT_SUBS"
+#define MEMO_VAR(className) (className + "_#MEMO")
+#define MEMO_INSTANCE_VAR(fncName) ("#memo_" + fncName)
 
 //////////////////////////////////////////////////////////////
 //  Group: Internal Macros
@@ -45,33 +78,906 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define ENSURE_INDEX(idx,dft) if ((count _this) <= idx) then {_this set [idx,dft]}
 #define CHECK_THIS if (isNil "_this") then {_this = []} else {if !(_this isEqualType []) then {_this = [_this]}}
 
-#define CHECK_ACCESS(lvl) case ((_access >= lvl) &&
-#define CHECK_TYPE(typeStr) ((_argType isEqualTo toUpper(typeStr)) || {toUpper(typeStr) isEqualTo "ANY"})
 #define CHECK_NIL (_argType isEqualTo "")
 #define CHECK_MEMBER(name) (_member == name)
+#ifdef OOP_RELEASE
+#define CHECK_TYPE(typeStr) true
+#define CHECK_VAR(typeStr,varName) {CHECK_MEMBER(varName)}
+#else
+#define CHECK_TYPE(typeStr) ((_argType == typeStr) || {typeStr == "ANY"})
 #define CHECK_VAR(typeStr,varName) {CHECK_MEMBER(varName)} && {CHECK_TYPE(typeStr) || CHECK_NIL}
+#endif
 
 #define GETVAR(var) (_classID + "_" + var)
 #define GETSVAR(var) (_class + "_" + var)
 #define GETCLASS(className) (NAMESPACE getVariable [className, {nil}])
 #define CALLCLASS(className,member,args,access) ([_classID, member, SAFE_VAR(args), access] call GETCLASS(className))
 
-#define VAR_DFT_FUNC(varName) {if (isNil "_this") then {NAMESPACE getVariable [GETVAR(varName), nil]} else {NAMESPACE setVariable [GETVAR(varName), _this]};}
-#define UIVAR_DFT_FUNC(varName) {if (isNil "_this") then {UINAMESPACE getVariable [GETVAR(varName), nil]} else {UINAMESPACE setVariable [GETVAR(varName), _this]};}
+#ifdef OOP_CLASS_STORAGE
+#define DATA_NAMESPACE _oopStore
+#define GETCLASSSTORE(className) (NAMESPACE getVariable CLASS_STORE_VAR(className))
+#define BIND_STORE(className) private _oopStore = GETCLASSSTORE(className)
+#define CLASS_OF_ID(classID) (call {private _index = (count classID) - 1; while {(classID select [_index,1]) != "_"} do {_index = _index - 1}; classID select [0,_index]})
+#define BIND_ID_STORE private _oopStore = GETCLASSSTORE(CLASS_OF_ID(_classID))
+#define STORAGE_INIT(className,parentClassName) \
+	if (parentClassName isEqualTo "") then { \
+		if (isNil {GETCLASSSTORE(className)}) then {NAMESPACE setVariable [CLASS_STORE_VAR(className), createLocation ["Invisible", [0,0,0], 0, 0]]}; \
+	} else { \
+		NAMESPACE setVariable [CLASS_STORE_VAR(className), GETCLASSSTORE(parentClassName)]; \
+	}
+#else
+#define DATA_NAMESPACE NAMESPACE
+#define BIND_STORE(className)
+#define BIND_ID_STORE
+#define STORAGE_INIT(className,parentClassName)
+#endif
+
+#ifdef OOP_RECYCLE_IDS
+#ifndef OOP_HASHMAP_STORAGE
+#ifndef OOP_AUTO_CLEANUP
+#define OOP_AUTO_CLEANUP
+#endif
+#endif
+#endif
+
+#ifdef OOP_HASHMAP_STORAGE
+#define STORE_INIT(ns) ns setVariable [_classID, createHashMap]
+#define STORE_CLEAR(ns) ns setVariable [_classID, nil]
+#define STORE_GET(ns,varName) ((ns getVariable _classID) get varName)
+#define STORE_SET(ns,varName,value) ((ns getVariable _classID) set [varName, value])
+#define STORE_DELETE(ns,varName) ((ns getVariable _classID) deleteAt varName)
+#define INSTANCE_ALIVE (!isNil {DATA_NAMESPACE getVariable _classID})
+#define STORE_ENSURE(ns) if (isNil {ns getVariable _classID}) then {STORE_INIT(ns)}
+#else
+#ifdef OOP_AUTO_CLEANUP
+#define STORE_INIT(ns) ns setVariable [TRACK_VAR(_classID), createHashMap]
+#define STORE_CLEAR(ns) {ns setVariable [GETVAR(_x), nil]} forEach (keys (ns getVariable [TRACK_VAR(_classID), createHashMap])); ns setVariable [TRACK_VAR(_classID), nil]
+#define STORE_SET(ns,varName,value) ns setVariable [GETVAR(varName), value]; (ns getVariable TRACK_VAR(_classID)) set [varName, true]
+#define INSTANCE_ALIVE (!isNil {DATA_NAMESPACE getVariable TRACK_VAR(_classID)})
+#define STORE_ENSURE(ns) if (isNil {ns getVariable TRACK_VAR(_classID)}) then {STORE_INIT(ns)}
+#else
+#define STORE_INIT(ns)
+#define STORE_CLEAR(ns)
+#define STORE_SET(ns,varName,value) (ns setVariable [GETVAR(varName), value])
+#define INSTANCE_ALIVE true
+#define STORE_ENSURE(ns)
+#endif
+#define STORE_GET(ns,varName) (ns getVariable [GETVAR(varName), nil])
+#define STORE_DELETE(ns,varName) (ns setVariable [GETVAR(varName), nil])
+#endif
+
+#ifdef OOP_HASHMAP_STORAGE
+#define UISTORE_GET(varName) ((UINAMESPACE getVariable [_classID, createHashMap]) get varName)
+#define UISTORE_DELETE(varName) ((UINAMESPACE getVariable [_classID, createHashMap]) deleteAt varName)
+#else
+#define UISTORE_GET(varName) STORE_GET(UINAMESPACE,varName)
+#define UISTORE_DELETE(varName) STORE_DELETE(UINAMESPACE,varName)
+#endif
+
+#ifdef OOP_RECYCLE_IDS
+#define ALLOC_ID(className) \
+	private _freeIDs = DATA_NAMESPACE getVariable [FREE_IDS_VAR(className), []]; \
+	private _classID = if ((count _freeIDs) > 0) then {_freeIDs deleteAt ((count _freeIDs) - 1)} else { \
+		DATA_NAMESPACE setVariable [AUTO_INC_VAR(className), (GET_AUTO_INC(className) + 1)]; \
+		className + "_" + str(GET_AUTO_INC(className)) \
+	}; \
+	DEAD_FORGET
+#define RECYCLE_ID(className) \
+	private _freeIDs = DATA_NAMESPACE getVariable FREE_IDS_VAR(className); \
+	if (isNil "_freeIDs") then {_freeIDs = []; DATA_NAMESPACE setVariable [FREE_IDS_VAR(className), _freeIDs]}; \
+	_freeIDs pushBackUnique _classID
+#else
+#define ALLOC_ID(className) \
+	DATA_NAMESPACE setVariable [AUTO_INC_VAR(className), (GET_AUTO_INC(className) + 1)]; \
+	private _classID = className + "_" + str(GET_AUTO_INC(className))
+#define RECYCLE_ID(className)
+#endif
+
+#define CREATE_INSTANCE(className,args) \
+	ALLOC_ID(className); \
+	BUILD_INSTANCE(className,args)
+
+#define BUILD_INSTANCE(className,args) \
+	INIT_INSTANCE(className); \
+	[_classID, CONSTRUCTOR_METHOD, args, 0] call GETCLASS(className)
+
+#define INIT_INSTANCE(className) \
+	PROFILE_COUNT(className,"#new"); \
+	STORE_INIT(DATA_NAMESPACE); \
+	private _code = MAKE_INSTANCE(className,_classID); \
+	REGISTRY_ADD(className,_classID,_code); \
+	THIS_INIT(className)
+
+#define DELETE_INSTANCE(className) \
+	if (INSTANCE_ALIVE) then { \
+		private _result = [_classID, DECONSTRUCTOR_METHOD, SAFE_VAR(_this), 0] call GETCLASS(className); \
+		POOL_FORGET(className); \
+		REGISTRY_REMOVE(className,_classID); \
+		WEAK_FORGET; \
+		EVENTS_FORGET; \
+		REPLICATION_FORGET; \
+		STORE_CLEAR(DATA_NAMESPACE); \
+		STORE_CLEAR(UINAMESPACE); \
+		RECYCLE_ID(className); \
+		SAFE_VAR(_result) \
+	}
 
-#define SVAR_DFT_FUNC(varName) {if (isNil "_this") then {NAMESPACE getVariable [GETSVAR(varName), nil]} else {NAMESPACE setVariable [GETSVAR(varName), _this]};}
+#define VAR_DFT_FUNC(varName) {if (isNil "_this") then {STORE_GET(DATA_NAMESPACE,varName)} else {STORE_SET(DATA_NAMESPACE,varName,_this)};}
+#define LAZYVAR_DFT_FUNC(varName,initCode) {if (isNil "_this") then { \
+	private _lazyValue = STORE_GET(DATA_NAMESPACE,varName); \
+	if (isNil "_lazyValue") then { \
+		_lazyValue = call (initCode); \
+		if !(isNil "_lazyValue") then {STORE_SET(DATA_NAMESPACE,varName,_lazyValue)}; \
+	}; \
+	SAFE_VAR(_lazyValue) \
+	} else {STORE_SET(DATA_NAMESPACE,varName,_this)};}
+#define UIVAR_DFT_FUNC(varName) {if (isNil "_this") then {UISTORE_GET(varName)} else {STORE_ENSURE(UINAMESPACE); STORE_SET(UINAMESPACE,varName,_this)};}
+
+#define SVAR_DFT_FUNC(varName) {if (isNil "_this") then {DATA_NAMESPACE getVariable [GETSVAR(varName), nil]} else {DATA_NAMESPACE setVariable [GETSVAR(varName), _this]};}
+#define SVAR_KEYED_FORMAT 'if (isNil "_this") then {DATA_NAMESPACE getVariable [%1, nil]} else {DATA_NAMESPACE setVariable [%1, _this]}'
+#define SUIVAR_KEYED_FORMAT 'if (isNil "_this") then {UINAMESPACE getVariable [%1, nil]} else {UINAMESPACE setVariable [%1, _this]}'
 #define SUIVAR_DFT_FUNC(varName) {if (isNil "_this") then {UINAMESPACE getVariable [GETSVAR(varName), nil]} else {UINAMESPACE setVariable [GETSVAR(varName), _this]};}
 
-#define VAR_DELETE(varName) (NAMESPACE setVariable [GETVAR(varName), nil])
-#define UIVAR_DELETE(varName) (UINAMESPACE setVariable [GETVAR(varName), nil])
+#ifdef OOP_RELEASE
+#define CHECK_STORED_TYPE(ns,varName)
+#else
+#define CHECK_STORED_TYPE(ns,varName) if (!(isNil "_varValue") && {!(isNil {STORE_GET(ns,varName)})} && {!(_varValue isEqualType STORE_GET(ns,varName))}) then { \
+	diag_log format ["OOP: %1 variable %2 set with %3 instead of %4", _classID, varName, typeName _varValue, typeName STORE_GET(ns,varName)]; \
+	}
+#endif
+#define VAR_SET_DIRECT(ns,varName,value) private _varValue = value; CHECK_STORED_TYPE(ns,varName); STORE_SET(ns,varName,_varValue)
 
-#define MOD_VAR(varName,mod) MEMBER(varName,MEMBER(varName,nil)+mod); 
-#define INC_VAR(varName) MOD_VAR(varName,1)
-#define DEC_VAR(varName) MOD_VAR(varName,-1)
-#define PUSH_ARR(varName,array) MOD_VAR(varName,array)
-#define REM_ARR(varName,array) MOD_VAR(varName,array)
+#define VAR_DELETE(varName) STORE_DELETE(DATA_NAMESPACE,varName)
+#define UIVAR_DELETE(varName) UISTORE_DELETE(varName)
+
+
+#define GET_AUTO_INC(className) (DATA_NAMESPACE getVariable [AUTO_INC_VAR(className),0])
+
+//////////////////////////////////////////////////////////////
+//  Group: Dispatch Macros
+//////////////////////////////////////////////////////////////
+
+#define MEMBER_TABLE_VAR(className) (className + "_#MT")
+#define RESOLVE_TABLE_VAR(className) (className + "_#RT")
+#define PARENT_VAR(className) (className + "_#PARENT")
+#define GETTABLE(className) (NAMESPACE getVariable MEMBER_TABLE_VAR(className))
+#define GETPARENT(className) (NAMESPACE getVariable [PARENT_VAR(className), ""])
+#ifdef OOP_RELEASE
+#define TABLE_KEY(member,typeStr) (member)
+#define TABLE_FIND(table,access,var) \
+	{if ((access) >= (_x select 0)) exitWith {var = _x select 2}} forEach ((table) getOrDefault [_member, []])
+#else
+#define TABLE_KEY(member,typeStr) [member, typeStr]
+#define TABLE_FIND(table,access,var) \
+	{if ((access) >= (_x select 0)) exitWith {var = _x select 2}} forEach ((table) getOrDefault [[_member, _argType], []]); \
+	if (isNil QUOTE(var)) then {{if ((access) >= (_x select 0)) exitWith {var = _x select 2}} forEach ((table) getOrDefault [[_member, "ANY"], []])}
+#endif
+#ifdef OOP_HANDLES
+#define MAKE_INSTANCE(className,classID) [className, classID]
+#define CALL_INSTANCE(instance,memberStr,args) ([instance select 1, memberStr, SAFE_VAR(args), 0] call GETCLASS(instance select 0))
+#define THIS_INIT(className) STORE_SET(DATA_NAMESPACE,"this",_code)
+#else
+#define MAKE_INSTANCE(className,classID) (compile format ['CHECK_THIS; ENSURE_INDEX(1,nil); (["%1", (_this select 0), (_this select 1), 0]) call GETCLASS(className);', classID])
+#define CALL_INSTANCE(instance,memberStr,args) ([memberStr, SAFE_VAR(args)] call instance)
+#define THIS_INIT(className) [_classID, "this", SAFE_VAR(_code), 2] call GETCLASS(className)
+#endif
+
+#define CLASS_FALLBACK(parentClassName) if (parentClassName isEqualTo "") then {nil} else {CALLCLASS(parentClassName,_member,_this,1)}
+
+//////////////////////////////////////////////////////////////
+//  Group: Profiler Macros
+//////////////////////////////////////////////////////////////
+
+#define PROFILE_VAR "OOP_PROFILE_DATA"
+#define GETPROFILE (NAMESPACE getVariable PROFILE_VAR)
+
+#ifdef OOP_PROFILE
+#define PROFILE_INIT if (isNil {GETPROFILE}) then {NAMESPACE setVariable [PROFILE_VAR, createHashMap]}
+#define PROFILE_BEGIN private _profileClass = _class; private _profileStart = diag_tickTime; private _result =
+#define PROFILE_RECORD(className,member,time) \
+	private _profileStat = GETPROFILE get [className, member]; \
+	if (isNil "_profileStat") then {GETPROFILE set [[className, member], [1, time, time]]} else { \
+		_profileStat set [0, (_profileStat select 0) + 1]; \
+		_profileStat set [1, (_profileStat select 1) + time]; \
+		_profileStat set [2, (_profileStat select 2) max time]; \
+	}
+#define PROFILE_END \
+	private _profileTime = diag_tickTime - _profileStart; \
+	PROFILE_RECORD(_profileClass,_member,_profileTime); \
+	SAFE_VAR(_result)
+#define PROFILE_COUNT(className,member) PROFILE_RECORD(className,member,0)
+#define PROFILE_DUMP(className) \
+	private _rows = []; \
+	{ \
+		if ((className isEqualTo "") || {(_x select 0) == className}) then {_rows pushBack [_y select 1, _x select 0, _x select 1, _y select 0, _y select 2]}; \
+	} forEach GETPROFILE; \
+	_rows sort false; \
+	{ \
+		diag_log format ["OOP_PROFILE,%1,%2,%3,%4,%5", _x select 1, _x select 2, _x select 3, (_x select 0) * 1000, (_x select 4) * 1000]; \
+	} forEach _rows; \
+	_rows
+#define PROFILE_BUILTINS(className) \
+	case "profile": { \
+		PROFILE_DUMP(className); \
+	};
+#else
+#define PROFILE_INIT
+#define PROFILE_BEGIN
+#define PROFILE_END
+#define PROFILE_COUNT(className,member)
+#define PROFILE_DUMP(className) []
+#define PROFILE_BUILTINS(className)
+#endif
+
+//////////////////////////////////////////////////////////////
+//  Group: Scheduler Macros
+//////////////////////////////////////////////////////////////
+
+#define ASYNC_QUEUE_VAR "OOP_ASYNC_QUEUE"
+#define ASYNC_DIRTY_VAR "OOP_ASYNC_DIRTY"
+#define ASYNC_SEQ_VAR "OOP_ASYNC_SEQ"
+#define GETASYNCQUEUE (NAMESPACE getVariable ASYNC_QUEUE_VAR)
+
+#define ASYNC_NEXT_SEQ (call {private _seq = NAMESPACE getVariable [ASYNC_SEQ_VAR, 0]; NAMESPACE setVariable [ASYNC_SEQ_VAR, _seq + 1]; _seq})
+#define ASYNC_ENSURE \
+	if (isNil {GETASYNCQUEUE}) then { \
+		NAMESPACE setVariable [ASYNC_QUEUE_VAR, []]; \
+		NAMESPACE setVariable [ASYNC_DIRTY_VAR, false]; \
+		addMissionEventHandler ["EachFrame", {ASYNC_DRAIN}]; \
+	}
+
+#define ASYNC_DRAIN \
+	private _queue = GETASYNCQUEUE; \
+	if ((count _queue) > 0) then { \
+		if (NAMESPACE getVariable [ASYNC_DIRTY_VAR, false]) then {_queue sort true; NAMESPACE setVariable [ASYNC_DIRTY_VAR, false]}; \
+		private _deadline = diag_tickTime + OOP_ASYNC_BUDGET; \
+		private _done = 0; \
+		while {(_done < (count _queue)) && {(_done == 0) || {diag_tickTime < _deadline}}} do { \
+			(_queue select _done) params ["", "", "_self", "_target", "_member", "_args", "_callback"]; \
+			private _result = if (_self) then { \
+				[_target select 1, _member, SAFE_VAR(_args), 2] call GETCLASS(_target select 0) \
+			} else { \
+				CALL_INSTANCE(_target,_member,_args) \
+			}; \
+			if !(isNil "_callback") then {[_target, SAFE_VAR(_result)] call _callback}; \
+			_done = _done + 1; \
+		}; \
+		_queue deleteRange [0, _done]; \
+	}
+
+#define ASYNC_PUSH(priority,self,target,memberStr,args,callback) \
+	ASYNC_ENSURE; \
+	GETASYNCQUEUE pushBack [-(priority), ASYNC_NEXT_SEQ, self, target, memberStr, SAFE_VAR(args), SAFE_VAR(callback)]; \
+	NAMESPACE setVariable [ASYNC_DIRTY_VAR, true]
+
+#define GETDEAD (NAMESPACE getVariable DEAD_VAR)
+#ifdef OOP_DELETE_DEFERRED
+#define DEAD_INIT if (isNil {GETDEAD}) then {NAMESPACE setVariable [DEAD_VAR, createHashMap]}
+#define DEAD_GUARD if ((_access == 0) && {_classID in GETDEAD}) exitWith {nil}
+#define DEAD_FORGET GETDEAD deleteAt _classID
+#define DELETE_DEFER(className) \
+	if (!(_classID in GETDEAD) && {INSTANCE_ALIVE}) then { \
+		GETDEAD set [_classID, true]; \
+		REGISTRY_REMOVE(className,_classID); \
+		WEAK_FORGET; \
+		ASYNC_PUSH(-1,true,(+[className, _classID]),REAP_METHOD,_this,nil); \
+	}
+#define DELETE_REAP(className) DELETE_INSTANCE(className); REAP_FORGET
+#ifdef OOP_HASHMAP_STORAGE
+#define REAP_FORGET DEAD_FORGET
+#else
+#ifdef OOP_AUTO_CLEANUP
+#define REAP_FORGET DEAD_FORGET
+#else
+#define REAP_FORGET
+#endif
+#endif
+#else
+#define DEAD_INIT
+#define DEAD_GUARD
+#define DEAD_FORGET
+#define DELETE_DEFER(className) DELETE_INSTANCE(className)
+#define DELETE_REAP(className)
+#endif
+
+//////////////////////////////////////////////////////////////
+//  Group: Replication Macros
+//////////////////////////////////////////////////////////////
+
+#define REPLICATION_DIRTY_VAR "OOP_REPLICATION_DIRTY"
+#define REPLICATION_STATE_VAR "OOP_REPLICATION_STATE"
+#define REPLICATION_NEXT_VAR "OOP_REPLICATION_NEXT"
+#define REPLICATION_APPLY_FNC "OOP_fnc_replicationApply"
+#define REPLICATION_REQUEST_FNC "OOP_fnc_replicationRequest"
+#define GETREPDIRTY (NAMESPACE getVariable REPLICATION_DIRTY_VAR)
+#define GETREPSTATE (NAMESPACE getVariable REPLICATION_STATE_VAR)
+#define SENT_BY_SERVER (remoteExecutedOwner isEqualTo 2)
+#define SENT_BY_HEADLESS (isServer && {remoteExecutedOwner in ((entities "HeadlessClient_F") apply {owner _x})})
+
+#ifdef OOP_REPLICATION
+#define REPLICATION_PACK(classID,names,alive) \
+	private _classID = classID; \
+	BIND_ID_STORE; \
+	private _values = []; \
+	{_values pushBack [_x, (if (alive) then {STORE_GET(DATA_NAMESPACE,_x)} else {nil})]} forEach (keys names); \
+	_packet pushBack [_classID, _values, alive]
+
+#define REPLICATION_FLUSH \
+	private _dirty = GETREPDIRTY; \
+	if ((count _dirty) > 0) then { \
+		NAMESPACE setVariable [REPLICATION_DIRTY_VAR, createHashMap]; \
+		private _packet = []; \
+		{ \
+			private _alive = _x in GETREPSTATE; \
+			REPLICATION_PACK(_x,_y,_alive); \
+		} forEach _dirty; \
+		[_packet] remoteExecCall [REPLICATION_APPLY_FNC, -2]; \
+	}
+
+#define REPLICATION_INIT \
+	if (isNil {missionNamespace getVariable REPLICATION_APPLY_FNC}) then { \
+		NAMESPACE setVariable [REPLICATION_DIRTY_VAR, createHashMap]; \
+		NAMESPACE setVariable [REPLICATION_STATE_VAR, createHashMap]; \
+		missionNamespace setVariable [REPLICATION_APPLY_FNC, compileFinal toString { \
+			if !(SENT_BY_SERVER) exitWith {}; \
+			{ \
+				_x params ["_classID", "_values", "_alive"]; \
+				BIND_ID_STORE; \
+				if (_alive) then { \
+					STORE_ENSURE(DATA_NAMESPACE); \
+					{ \
+						if (isNil {_x select 1}) then {STORE_DELETE(DATA_NAMESPACE,(_x select 0))} else {STORE_SET(DATA_NAMESPACE,(_x select 0),(_x select 1))}; \
+					} forEach _values; \
+				} else { \
+					{STORE_DELETE(DATA_NAMESPACE,(_x select 0))} forEach _values; \
+					STORE_CLEAR(DATA_NAMESPACE); \
+				}; \
+			} forEach (_this select 0); \
+		}]; \
+		missionNamespace setVariable [REPLICATION_REQUEST_FNC, compileFinal toString { \
+			if !(isServer) exitWith {}; \
+			private _packet = []; \
+			{ \
+				REPLICATION_PACK(_x,_y,true); \
+			} forEach GETREPSTATE; \
+			[_packet] remoteExecCall [REPLICATION_APPLY_FNC, remoteExecutedOwner]; \
+		}]; \
+		if (isServer) then { \
+			NAMESPACE setVariable [REPLICATION_NEXT_VAR, 0]; \
+			addMissionEventHandler ["EachFrame", { \
+				if (diag_tickTime >= (NAMESPACE getVariable REPLICATION_NEXT_VAR)) then { \
+					NAMESPACE setVariable [REPLICATION_NEXT_VAR, diag_tickTime + OOP_REPLICATION_INTERVAL]; \
+					REPLICATION_FLUSH; \
+				}; \
+			}]; \
+		} else { \
+			if (didJIP) then {[] remoteExecCall [REPLICATION_REQUEST_FNC, 2]}; \
+		}; \
+	}
+
+#define REPLICATION_MARK(varName) \
+	if (isServer) then { \
+		private _names = GETREPSTATE get _classID; \
+		if (isNil "_names") then {_names = createHashMap; GETREPSTATE set [_classID, _names]}; \
+		_names set [varName, true]; \
+		private _dirty = GETREPDIRTY get _classID; \
+		if (isNil "_dirty") then {_dirty = createHashMap; GETREPDIRTY set [_classID, _dirty]}; \
+		_dirty set [varName, true]; \
+	}
+
+#define REPLICATION_TOUCH(varName) \
+	if (isServer) then { \
+		private _repNames = NAMESPACE getVariable REPNAMES_VAR(_class); \
+		if (isNil "_repNames") then { \
+			_repNames = createHashMap; \
+			{_repNames set [_x, true]} forEach ([_classID, REPLICATED_METHOD, [], 2] call GETCLASS(_class)); \
+			NAMESPACE setVariable [REPNAMES_VAR(_class), _repNames]; \
+		}; \
+		if ((varName) in _repNames) then {REPLICATION_MARK(varName)}; \
+	}
+#define VAR_TOUCHED(varName,expression) (call {private _varResult = expression; REPLICATION_TOUCH(varName); SAFE_VAR(_varResult)})
+
+#define REPLICATION_FORGET \
+	private _names = GETREPSTATE get _classID; \
+	if !(isNil "_names") then { \
+		GETREPSTATE deleteAt _classID; \
+		GETREPDIRTY set [_classID, _names]; \
+	}
+#else
+#define REPLICATION_INIT
+#define REPLICATION_MARK(varName)
+#define REPLICATION_TOUCH(varName)
+#define VAR_TOUCHED(varName,expression) (expression)
+#define REPLICATION_FORGET
+#endif
+
+#define REPVAR_DFT_FUNC(varName) {if (isNil "_this") then {STORE_GET(DATA_NAMESPACE,varName)} else {STORE_SET(DATA_NAMESPACE,varName,_this); REPLICATION_MARK(varName)};}
+
+//////////////////////////////////////////////////////////////
+//  Group: Remote Macros
+//////////////////////////////////////////////////////////////
+
+#define REMOTE_QUEUE_VAR "OOP_REMOTE_QUEUE"
+#define REMOTE_LOAD_VAR "OOP_REMOTE_LOAD"
+#define REMOTE_INC_VAR(className) (className + "_#IDREMOTE")
+#define REMOTE_NEW_FNC "OOP_fnc_remoteNew"
+#define REMOTE_BATCH_FNC "OOP_fnc_remoteBatch"
+#define GETREMOTEQUEUE (NAMESPACE getVariable REMOTE_QUEUE_VAR)
+#define GETREMOTELOAD (NAMESPACE getVariable REMOTE_LOAD_VAR)
+
+#ifdef OOP_REMOTE
+#define REMOTE_INIT \
+	if (isNil {missionNamespace getVariable REMOTE_BATCH_FNC}) then { \
+		NAMESPACE setVariable [REMOTE_QUEUE_VAR, createHashMap]; \
+		NAMESPACE setVariable [REMOTE_LOAD_VAR, createHashMap]; \
+		missionNamespace setVariable [REMOTE_NEW_FNC, compileFinal toString { \
+			if !(SENT_BY_SERVER) exitWith {}; \
+			params ["_className", "_classID", "_args"]; \
+			["adopt", [_classID, _args]] call GETCLASS(_className); \
+		}]; \
+		missionNamespace setVariable [REMOTE_BATCH_FNC, compileFinal toString { \
+			if !(SENT_BY_SERVER || {SENT_BY_HEADLESS}) exitWith {}; \
+			{ \
+				_x params ["_className", "_classID", "_member", "_args"]; \
+				[_classID, _member, _args, 0] call GETCLASS(_className); \
+			} forEach (_this select 0); \
+		}]; \
+		addMissionEventHandler ["EachFrame", { \
+			private _queue = GETREMOTEQUEUE; \
+			if ((count _queue) > 0) then { \
+				NAMESPACE setVariable [REMOTE_QUEUE_VAR, createHashMap]; \
+				{[_y] remoteExecCall [REMOTE_BATCH_FNC, _x]} forEach _queue; \
+			}; \
+		}]; \
+	}
+
+#define REMOTE_PICK_OWNER \
+	private _owner = clientOwner; \
+	if (isServer) then { \
+		private _load = GETREMOTELOAD; \
+		private _best = _load getOrDefault [_owner, 0]; \
+		{ \
+			private _candidate = owner _x; \
+			private _count = _load getOrDefault [_candidate, 0]; \
+			if (_count <= _best) then {_owner = _candidate; _best = _count}; \
+		} forEach (entities "HeadlessClient_F"); \
+		_load set [_owner, _best + 1]; \
+	}
+
+#define REMOTE_PUSH(owner,packet) \
+	private _batch = GETREMOTEQUEUE get owner; \
+	if (isNil "_batch") then {_batch = []; GETREMOTEQUEUE set [owner, _batch]}; \
+	_batch pushBack packet
+
+#define REMOTE_BUILTINS(className) \
+	case "newRemote": { \
+		ENSURE_INDEX(1,nil); \
+		REMOTE_PICK_OWNER; \
+		NAMESPACE setVariable [REMOTE_INC_VAR(className), (NAMESPACE getVariable [REMOTE_INC_VAR(className), 0]) + 1]; \
+		private _classID = className + "_r" + str clientOwner + "n" + str (NAMESPACE getVariable REMOTE_INC_VAR(className)); \
+		if (_owner isEqualTo clientOwner) then { \
+			BUILD_INSTANCE(className,(_this select 1)); \
+		} else { \
+			[className, _classID, (_this select 1)] remoteExecCall [REMOTE_NEW_FNC, _owner]; \
+		}; \
+		[className, _classID, _owner]; \
+	}; \
+	case "adopt": { \
+		private _classID = (_this select 1) select 0; \
+		BUILD_INSTANCE(className,((_this select 1) select 1)); \
+		_code; \
+	};
+#else
+#define REMOTE_INIT
+#define REMOTE_BUILTINS(className)
+#endif
+
+//////////////////////////////////////////////////////////////
+//  Group: Registry Macros
+//////////////////////////////////////////////////////////////
+
+#define GETREGISTRY(className) (NAMESPACE getVariable [REGISTRY_VAR(className), createHashMap])
+
+#ifdef OOP_REGISTRY
+#define REGISTRY_INIT(className) if (isNil {NAMESPACE getVariable REGISTRY_VAR(className)}) then {NAMESPACE setVariable [REGISTRY_VAR(className), createHashMap]}
+#define REGISTRY_ADD(className,classID,instance) (GETREGISTRY(className) set [classID, instance])
+#define REGISTRY_REMOVE(className,classID) (GETREGISTRY(className) deleteAt classID)
+#else
+#define REGISTRY_INIT(className)
+#define REGISTRY_ADD(className,classID,instance)
+#define REGISTRY_REMOVE(className,classID)
+#endif
+
+//////////////////////////////////////////////////////////////
+//  Group: Reference Macros
+//////////////////////////////////////////////////////////////
+
+#define GETWEAKS (NAMESPACE getVariable WEAK_VAR)
+#define WEAK_INIT if (isNil {GETWEAKS}) then {NAMESPACE setVariable [WEAK_VAR, createHashMap]; NAMESPACE setVariable [WEAK_SEQ_VAR, 0]}
+#define WEAK_FORGET GETWEAKS deleteAt _classID
+
+#define REF_RETAIN \
+	private _refs = STORE_GET(DATA_NAMESPACE,REFS_VAR); \
+	_refs = (if (isNil "_refs") then {1} else {_refs}) + 1; \
+	STORE_SET(DATA_NAMESPACE,REFS_VAR,_refs); \
+	_refs
+
+#define REF_RELEASE(className) \
+	private _refs = STORE_GET(DATA_NAMESPACE,REFS_VAR); \
+	_refs = (if (isNil "_refs") then {1} else {_refs}) - 1; \
+	if (_refs > 0) then { \
+		STORE_SET(DATA_NAMESPACE,REFS_VAR,_refs); \
+		_refs \
+	} else { \
+		STORE_DELETE(DATA_NAMESPACE,REFS_VAR); \
+		POOL_RELEASE(className); \
+	}
+
+#define WEAK_REF(className) \
+	private _token = GETWEAKS get _classID; \
+	if (isNil "_token") then { \
+		_token = NAMESPACE getVariable WEAK_SEQ_VAR; \
+		NAMESPACE setVariable [WEAK_SEQ_VAR, _token + 1]; \
+		GETWEAKS set [_classID, _token]; \
+	}; \
+	private _weakTarget = GETREGISTRY(className) get _classID; \
+	if (isNil "_weakTarget") then {_weakTarget = (GETPOOL(className) getOrDefault [_classID, []]) param [0]}; \
+	if (isNil "_weakTarget") then {_weakTarget = MAKE_INSTANCE(className,_classID)}; \
+	[_weakTarget, _classID, _token]
+
+//////////////////////////////////////////////////////////////
+//  Group: Event Macros
+//////////////////////////////////////////////////////////////
+
+#define GETEVENTS (NAMESPACE getVariable EVENTS_VAR)
+#define GETEVENTSUBS (NAMESPACE getVariable EVENT_SUBS_VAR)
+#define EVENT_INIT if (isNil {GETEVENTS}) then {NAMESPACE setVariable [EVENTS_VAR, createHashMap]; NAMESPACE setVariable [EVENT_SUBS_VAR, createHashMap]}
+#define EVENT_SUBSCRIBERS(eventKey) ((GETEVENTS getOrDefault [(eventKey) select 0, createHashMap]) getOrDefault [(eventKey) select 1, createHashMap])
+
+#define EVENT_ADD(eventKey,code) \
+	private _oopEvents = GETEVENTS get ((eventKey) select 0); \
+	if (isNil "_oopEvents") then {_oopEvents = createHashMap; GETEVENTS set [(eventKey) select 0, _oopEvents]}; \
+	private _oopSubs = _oopEvents get ((eventKey) select 1); \
+	if (isNil "_oopSubs") then {_oopSubs = createHashMap; _oopEvents set [(eventKey) select 1, _oopSubs]}; \
+	_oopSubs set [_classID, [_classID, _class, code]]; \
+	private _oopMine = GETEVENTSUBS get _classID; \
+	if (isNil "_oopMine") then {_oopMine = createHashMap; GETEVENTSUBS set [_classID, _oopMine]}; \
+	_oopMine set [eventKey, true]
+
+#define EVENT_REMOVE(eventKey) \
+	EVENT_SUBSCRIBERS(eventKey) deleteAt _classID; \
+	(GETEVENTSUBS getOrDefault [_classID, createHashMap]) deleteAt (eventKey)
 
-#define GET_AUTO_INC(className) (NAMESPACE getVariable [AUTO_INC_VAR(className),0])
+#define EVENTS_FORGET \
+	private _published = GETEVENTS get _classID; \
+	if !(isNil "_published") then { \
+		{ \
+			private _eventKey = [_classID, _x]; \
+			{(GETEVENTSUBS getOrDefault [_x, createHashMap]) deleteAt _eventKey} forEach _y; \
+		} forEach _published; \
+		GETEVENTS deleteAt _classID; \
+	}; \
+	private _subscriptions = GETEVENTSUBS get _classID; \
+	if !(isNil "_subscriptions") then { \
+		{EVENT_SUBSCRIBERS(_x) deleteAt _classID} forEach _subscriptions; \
+		GETEVENTSUBS deleteAt _classID; \
+	}
+
+//////////////////////////////////////////////////////////////
+//  Group: Memory Macros
+//////////////////////////////////////////////////////////////
+
+#define GETCLASSES (NAMESPACE getVariable CLASSES_VAR)
+#define CLASS_REGISTER(className,parentClassName) \
+	if (isNil {GETCLASSES}) then {NAMESPACE setVariable [CLASSES_VAR, createHashMap]}; \
+	GETCLASSES set [className, parentClassName]
+
+#ifdef OOP_HASHMAP_STORAGE
+#define MEMORY_IS_STORE (_sep < 0) && {(typeName _value) isEqualTo "HASHMAP"}
+#else
+#define MEMORY_IS_STORE false
+#endif
+#define MEMORY_META_MEMBER(name) ((name select [0,1]) isEqualTo "#")
+
+#define MEMORY_SCAN(ns,stats,statIndex) \
+	{ \
+		private _key = _x; \
+		if (((_key select [0, count _prefix]) isEqualTo _prefix) && {(_longer findIf {(_key select [0, count _x]) isEqualTo _x}) < 0}) then { \
+			private _rest = _x select [count _prefix]; \
+			private _sep = _rest find "_"; \
+			private _name = if (_sep < 0) then {""} else {_rest select [_sep + 1]}; \
+			if (!(_rest isEqualTo "idai") && {!MEMORY_META_MEMBER(_rest)} && {!MEMORY_META_MEMBER(_name)}) then { \
+				private _value = ns getVariable _x; \
+				private _id = if (_sep < 0) then {_rest} else {_rest select [0, _sep]}; \
+				private _remoteID = (_id select [0,1]) isEqualTo "r"; \
+				private _digits = toArray (if (_remoteID) then {_id select [1]} else {_id}); \
+				if (((count _digits) > 0) && {(_digits findIf {((_x < 48) || {_x > 57}) && {!_remoteID || {_x != 110}}}) < 0}) then {_ids set [_id, true]}; \
+				if (MEMORY_IS_STORE) then { \
+					{ \
+						if !(MEMORY_META_MEMBER(_x)) then { \
+							stats set [statIndex, (stats select statIndex) + 1]; \
+							stats set [4, (stats select 4) + (count str _y)]; \
+						}; \
+					} forEach _value; \
+				} else { \
+					stats set [statIndex, (stats select statIndex) + 1]; \
+					stats set [4, (stats select 4) + (count str _value)]; \
+				}; \
+			}; \
+		}; \
+	} forEach (allVariables ns)
+
+#define MEMORY_CLASS(className) \
+	private _memClass = className; \
+	BIND_STORE(_memClass); \
+	private _prefix = toLower (_memClass + "_"); \
+	private _longer = ((keys GETCLASSES) apply {toLower (_x + "_")}) select {((count _x) > (count _prefix)) && {(_x select [0, count _prefix]) isEqualTo _prefix}}; \
+	private _ids = createHashMap; \
+	private _stats = [_memClass, 0, 0, 0, 0, 0]; \
+	MEMORY_SCAN(DATA_NAMESPACE,_stats,2); \
+	MEMORY_SCAN(UINAMESPACE,_stats,3); \
+	_stats set [1, MEMORY_INSTANCES(_memClass)]; \
+	_stats set [5, GET_AUTO_INC(_memClass)]; \
+	_stats
+
+#ifdef OOP_REGISTRY
+#define MEMORY_INSTANCES(className) (count GETREGISTRY(className))
+#else
+#define MEMORY_INSTANCES(className) (count _ids)
+#endif
+
+#define MEMORY_LINE(tag,stats) diag_log (tag + ((stats apply {str _x}) joinString ","))
+
+//////////////////////////////////////////////////////////////
+//  Group: Pool Macros
+//////////////////////////////////////////////////////////////
+
+#define GETPOOL(className) (NAMESPACE getVariable POOL_VAR(className))
+#define GETPOOLFREE(className) (NAMESPACE getVariable POOL_FREE_VAR(className))
+#define GETPOOLSTATS(className) (NAMESPACE getVariable POOL_STATS_VAR(className))
+
+#define POOL_INIT(className) \
+	if (isNil {GETPOOL(className)}) then { \
+		NAMESPACE setVariable [POOL_VAR(className), createHashMap]; \
+		NAMESPACE setVariable [POOL_FREE_VAR(className), []]; \
+		NAMESPACE setVariable [POOL_STATS_VAR(className), [0,0,0]]; \
+	}
+
+#define POOL_ACQUIRE(className,args) \
+	private _code = nil; \
+	private _free = GETPOOLFREE(className); \
+	private _stats = GETPOOLSTATS(className); \
+	while {(isNil "_code") && {(count _free) > 0}} do { \
+		private _id = _free deleteAt ((count _free) - 1); \
+		private _entry = GETPOOL(className) get _id; \
+		if !(isNil "_entry") then { \
+			_entry set [1, false]; \
+			_code = _entry select 0; \
+			REGISTRY_ADD(className,_id,_code); \
+			[_id, CONSTRUCTOR_METHOD, args, 0] call GETCLASS(className); \
+		}; \
+	}; \
+	if (isNil "_code") then { \
+		_stats set [1, (_stats select 1) + 1]; \
+		_code = call {CREATE_INSTANCE(className,args); GETPOOL(className) set [_classID, [_code, false]]; _code}; \
+	} else { \
+		_stats set [0, (_stats select 0) + 1]; \
+	}
+
+#define POOL_RELEASE(className) \
+	private _entry = GETPOOL(className) get _classID; \
+	if (isNil "_entry") then {DELETE_INSTANCE(className)} else { \
+		if !(_entry select 1) then { \
+			[_classID, RESET_METHOD, SAFE_VAR(_this), 2] call GETCLASS(className); \
+			_entry set [1, true]; \
+			REGISTRY_REMOVE(className,_classID); \
+			WEAK_FORGET; \
+			private _free = GETPOOLFREE(className); \
+			_free pushBack _classID; \
+			private _stats = GETPOOLSTATS(className); \
+			_stats set [2, (_stats select 2) max (count _free)]; \
+		}; \
+	}
+
+#define POOL_FORGET(className) \
+	private _entry = GETPOOL(className) get _classID; \
+	if !(isNil "_entry") then { \
+		if (_entry select 1) then {GETPOOLFREE(className) deleteAt (GETPOOLFREE(className) find _classID)}; \
+		GETPOOL(className) deleteAt _classID; \
+	}
+
+//////////////////////////////////////////////////////////////
+//  Group: Bulk Macros
+//////////////////////////////////////////////////////////////
+
+#define BULK_FIELDS_INDEX 0
+#define BULK_COLUMNS_INDEX 1
+#define BULK_DEFAULTS_INDEX 2
+#define BULK_FREE_INDEX 3
+#define BULK_ALIVE_INDEX 4
+#define BULK_FUNCTIONS_INDEX 5
+
+#define GETBULK(className) (NAMESPACE getVariable BULK_VAR(className))
+#define BULK_BIND(className) \
+	private _bulk = GETBULK(className); \
+	private _bulkFields = _bulk select BULK_FIELDS_INDEX; \
+	private _bulkColumns = _bulk select BULK_COLUMNS_INDEX; \
+	private _bulkAlive = _bulk select BULK_ALIVE_INDEX
+#define BULK_CELL(fieldName) (_bulkColumns select (_bulkFields get fieldName))
+#define BULK_FLUSH if !(_oopBulkEntry isEqualTo "") then {_oopBulkFunctions set [_oopBulkEntry, _oopBulkCode]; _oopBulkEntry = ""}
+
+//////////////////////////////////////////////////////////////
+//  Group: Cache Macros
+//////////////////////////////////////////////////////////////
+
+#define GETMEMO(className) (NAMESPACE getVariable MEMO_VAR(className))
+#define MEMO_CLASS_CACHE(fncName) \
+	private _memoCache = GETMEMO(_class) get fncName; \
+	if ((isNil "_memoCache") || {(count _memoCache) >= OOP_CACHE_SIZE}) then {_memoCache = createHashMap; GETMEMO(_class) set [fncName, _memoCache]}
+#define MEMO_INSTANCE_CACHE(fncName) \
+	private _memoCache = STORE_GET(DATA_NAMESPACE,MEMO_INSTANCE_VAR(fncName)); \
+	if ((isNil "_memoCache") || {(count _memoCache) >= OOP_CACHE_SIZE}) then {_memoCache = createHashMap; STORE_SET(DATA_NAMESPACE,MEMO_INSTANCE_VAR(fncName),_memoCache)}
+#define MEMO_LOOKUP(compute) \
+	private _memoKey = if (isNil "_this") then {[]} else {[_this]}; \
+	private _memoHit = _memoCache get _memoKey; \
+	if (isNil "_memoHit") then { \
+		_memoHit = compute; \
+		if !(isNil "_memoHit") then {_memoCache set [_memoKey, _memoHit]}; \
+	}; \
+	SAFE_VAR(_memoHit)
+#define MEMO_BYPASS_ACCESS 3
+#define MEMO_COMPUTE ([_classID, _member, SAFE_VAR(_this), MEMO_BYPASS_ACCESS] call GETCLASS(_class))
+#define MEMO_CLASS_FORMAT 'private _memoBody = %1; MEMO_CLASS_CACHE(_member); MEMO_LOOKUP((call _memoBody))'
+#define MEMO_INSTANCE_FORMAT 'private _memoBody = %1; MEMO_INSTANCE_CACHE(_member); MEMO_LOOKUP((call _memoBody))'
+
+//////////////////////////////////////////////////////////////
+//  Group: Serialization Macros
+//////////////////////////////////////////////////////////////
+
+#define SERIALIZE_FORMAT 1
+#ifdef OOP_SERIALIZE
+#ifdef OOP_REPLICATION
+#define SCHEMA_PROBE private _schemaProbe = (_member isEqualTo SCHEMA_METHOD) || {_member isEqualTo REPLICATED_METHOD}
+#define CHECK_SCHEMA_MEMBER(name) (CHECK_MEMBER(name) || {_schemaProbe && {if (_member isEqualTo SCHEMA_METHOD) then {_this pushBackUnique name}; false}})
+#define CHECK_REPLICATED_MEMBER(name) (CHECK_MEMBER(name) || {_schemaProbe && {_this pushBackUnique name; false}})
+#else
+#define SCHEMA_PROBE private _schemaProbe = _member isEqualTo SCHEMA_METHOD
+#define CHECK_SCHEMA_MEMBER(name) (CHECK_MEMBER(name) || {_schemaProbe && {_this pushBackUnique name; false}})
+#define CHECK_REPLICATED_MEMBER(name) CHECK_SCHEMA_MEMBER(name)
+#endif
+#else
+#define CHECK_SCHEMA_MEMBER(name) CHECK_MEMBER(name)
+#ifdef OOP_REPLICATION
+#define SCHEMA_PROBE private _schemaProbe = _member isEqualTo REPLICATED_METHOD
+#define CHECK_REPLICATED_MEMBER(name) (CHECK_MEMBER(name) || {_schemaProbe && {_this pushBackUnique name; false}})
+#else
+#define SCHEMA_PROBE
+#define CHECK_REPLICATED_MEMBER(name) CHECK_MEMBER(name)
+#endif
+#endif
+
+#ifdef OOP_TABLE_DISPATCH
+#define SCHEMA_COLLECT(className) {_this pushBackUnique _x} forEach (NAMESPACE getVariable [OWNVARS_VAR(className), []])
+#define REPLICATED_COLLECT(className) {_this pushBackUnique _x} forEach (NAMESPACE getVariable [OWNREP_VAR(className), []])
+#else
+#define SCHEMA_COLLECT(className)
+#define REPLICATED_COLLECT(className)
+#endif
+
+#define GETSCHEMA(className) \
+	private _schema = NAMESPACE getVariable SCHEMA_VAR(className); \
+	if (isNil "_schema") then { \
+		_schema = [_classID, SCHEMA_METHOD, [], 2] call GETCLASS(className); \
+		NAMESPACE setVariable [SCHEMA_VAR(className), _schema]; \
+	}
+
+#define SCHEMA_INSTANCE(className,parentClassName) \
+	SCHEMA_COLLECT(className); \
+	if (parentClassName isEqualTo "") then {_this} else {[_classID, _member, _this, 2] call GETCLASS(parentClassName)}
+
+#define REPLICATED_INSTANCE(className,parentClassName) \
+	REPLICATED_COLLECT(className); \
+	if (parentClassName isEqualTo "") then {_this} else {[_classID, _member, _this, 2] call GETCLASS(parentClassName)}
+
+#define SERIALIZE_INSTANCE(className) \
+	GETSCHEMA(className); \
+	[[SERIALIZE_FORMAT, [_classID, SCHEMA_VERSION_METHOD, nil, 2] call GETCLASS(className)], _schema apply {STORE_GET(DATA_NAMESPACE,_x)}]
+
+#define DESERIALIZE_INSTANCE(className,data) \
+	ALLOC_ID(className); \
+	INIT_INSTANCE(className); \
+	GETSCHEMA(className); \
+	private _values = data select 1; \
+	{ \
+		private _value = _values param [_forEachIndex]; \
+		if !(isNil "_value") then {STORE_SET(DATA_NAMESPACE,_x,_value)}; \
+	} forEach _schema; \
+	[_classID, RESTORED_METHOD, ((data select 0) select 1), 2] call GETCLASS(className)
+
+#define IS_FRAMEWORK_MEMBER ((_member select [0,1]) isEqualTo "#")
+#define FRAMEWORK_MEMBERS(className,parentClassName) \
+	switch (_member) do { \
+		case DELETE_METHOD: {DELETE_INSTANCE(className)}; \
+		case RELEASE_METHOD: {REF_RELEASE(className)}; \
+		case RETAIN_METHOD: {REF_RETAIN}; \
+		case WEAK_METHOD: {WEAK_REF(className)}; \
+		case DELETE_DEFERRED_METHOD: {DELETE_DEFER(className)}; \
+		case REAP_METHOD: {DELETE_REAP(className)}; \
+		case SCHEMA_METHOD: {SCHEMA_INSTANCE(className,parentClassName)}; \
+		case SERIALIZE_METHOD: {SERIALIZE_INSTANCE(className)}; \
+		case REPLICATED_METHOD: {REPLICATED_INSTANCE(className,parentClassName)}; \
+	}
+
+#define DISPATCH_PARAMS \
+	private _classID = _this select 0; \
+	private _member = _this select 1; \
+	private _access = DEFAULT_PARAM(3,0); \
+	_this = DEFAULT_PARAM(2,nil); \
+	private _argType = if (isNil "_this") then {""} else {typeName _this}
+
+#ifdef OOP_TABLE_DISPATCH
+#define TABLE_FLUSH if ((count _oopEntry) > 0) then { \
+	private _oopKeys = [TABLE_KEY(_oopEntry select 0,_oopEntry select 1)]; \
+	if ((_oopEntry select 2) && {!((_oopEntry select 1) in ["", "ANY"])}) then {_oopKeys pushBackUnique TABLE_KEY(_oopEntry select 0,"")}; \
+	if (_oopEntry select 3) then {_oopSchema pushBackUnique (_oopEntry select 0)}; \
+	switch (_oopEntry param [4, 0]) do { \
+		case 1: {_oopCode = compile format [MEMO_CLASS_FORMAT, _oopCode]}; \
+		case 2: {_oopCode = compile format [MEMO_INSTANCE_FORMAT, _oopCode]}; \
+		case 3: {_oopCode = compile format [SVAR_KEYED_FORMAT, str (_oopClassName + "_" + (_oopEntry select 0))]}; \
+		case 4: {_oopCode = compile format [SUIVAR_KEYED_FORMAT, str (_oopClassName + "_" + (_oopEntry select 0))]}; \
+		case 5: {_oopReplicated pushBackUnique (_oopEntry select 0)}; \
+	}; \
+	{ \
+		if !(_x in _oopTable) then {_oopTable set [_x, []]}; \
+		(_oopTable get _x) pushBack [_oopAccess, _oopEntry select 1, _oopCode, _oopEntry select 2]; \
+	} forEach _oopKeys; \
+	_oopEntry = []; \
+	}
+#define TABLE_FALLBACK(className,parentClassName) \
+	if (parentClassName isEqualTo "") then {nil} else { \
+		private _resolveKey = [_member, _argType, _access min 1]; \
+		private _resolved = (NAMESPACE getVariable RESOLVE_TABLE_VAR(className)) get _resolveKey; \
+		if (isNil "_resolved") then { \
+			_resolved = []; \
+			private _ancestor = parentClassName; \
+			while {(_ancestor != "") && {(count _resolved) == 0}} do { \
+				private _found = nil; \
+				TABLE_FIND(GETTABLE(_ancestor),(_access min 1),_found); \
+				if !(isNil "_found") then {_resolved = [_ancestor, _found]}; \
+				_ancestor = GETPARENT(_ancestor); \
+			}; \
+			(NAMESPACE getVariable RESOLVE_TABLE_VAR(className)) set [_resolveKey, _resolved]; \
+		}; \
+		if ((count _resolved) == 0) then {nil} else {_class = _resolved select 0; call (_resolved select 1)}; \
+	}
+#define CHECK_ACCESS(lvl) TABLE_FLUSH; _oopAccess = lvl;
+#define DECLARE_FUNCTION(typeStr,fncName) _oopEntry = [fncName, toUpper(typeStr), false, false]; _oopCode =
+#define DECLARE_VARIABLE(typeStr,varName) _oopEntry = [varName, toUpper(typeStr), true, false]; _oopCode =
+#define DECLARE_INSTANCE_VARIABLE(typeStr,varName) _oopEntry = [varName, toUpper(typeStr), true, true]; _oopCode =
+#define DECLARE_REPLICATED_VARIABLE(typeStr,varName) _oopEntry = [varName, toUpper(typeStr), true, true, 5]; _oopCode =
+#define DECLARE_CACHED_FUNCTION(typeStr,fncName) _oopEntry = [fncName, toUpper(typeStr), false, false, 1]; _oopCode =
+#define DECLARE_CACHED_INSTANCE_FUNCTION(typeStr,fncName) _oopEntry = [fncName, toUpper(typeStr), false, false, 2]; _oopCode =
+#define DECLARE_STATIC_VARIABLE(typeStr,varName) _oopEntry = [varName, toUpper(typeStr), true, false, 3]; _oopCode =
+#define DECLARE_STATIC_UI_VARIABLE(typeStr,varName) _oopEntry = [varName, toUpper(typeStr), true, false, 4]; _oopCode =
+#else
+#define CHECK_ACCESS(lvl) case ((_access >= lvl) &&
+#ifdef OOP_RELEASE
+#define DECLARE_FUNCTION(typeStr,fncName) {CHECK_MEMBER(fncName)}):
+#define DECLARE_INSTANCE_VARIABLE(typeStr,varName) {CHECK_SCHEMA_MEMBER(varName)}):
+#define DECLARE_REPLICATED_VARIABLE(typeStr,varName) {CHECK_REPLICATED_MEMBER(varName)}):
+#define MEMO_MATCH(typeStr,fncName) {CHECK_MEMBER(fncName)}
+#else
+#define DECLARE_FUNCTION(typeStr,fncName) {CHECK_MEMBER(fncName)} && {CHECK_TYPE(typeStr)}):
+#define DECLARE_INSTANCE_VARIABLE(typeStr,varName) {CHECK_SCHEMA_MEMBER(varName)} && {CHECK_TYPE(typeStr) || CHECK_NIL}):
+#define DECLARE_REPLICATED_VARIABLE(typeStr,varName) {CHECK_REPLICATED_MEMBER(varName)} && {CHECK_TYPE(typeStr) || CHECK_NIL}):
+#define MEMO_MATCH(typeStr,fncName) {CHECK_MEMBER(fncName)} && {CHECK_TYPE(typeStr)}
+#endif
+#define DECLARE_CACHED_FUNCTION(typeStr,fncName) MEMO_MATCH(typeStr,fncName) && {_access < MEMO_BYPASS_ACCESS}): {MEMO_CLASS_CACHE(fncName); MEMO_LOOKUP(MEMO_COMPUTE)}; case ((_access == MEMO_BYPASS_ACCESS) && MEMO_MATCH(typeStr,fncName)):
+#define DECLARE_CACHED_INSTANCE_FUNCTION(typeStr,fncName) MEMO_MATCH(typeStr,fncName) && {_access < MEMO_BYPASS_ACCESS}): {MEMO_INSTANCE_CACHE(fncName); MEMO_LOOKUP(MEMO_COMPUTE)}; case ((_access == MEMO_BYPASS_ACCESS) && MEMO_MATCH(typeStr,fncName)):
+#define DECLARE_VARIABLE(typeStr,varName) CHECK_VAR(typeStr,varName)):
+#define DECLARE_STATIC_VARIABLE(typeStr,varName) DECLARE_VARIABLE(typeStr,varName)
+#define DECLARE_STATIC_UI_VARIABLE(typeStr,varName) DECLARE_VARIABLE(typeStr,varName)
+#endif
 
 
 //////////////////////////////////////////////////////////////
@@ -91,6 +997,134 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define UINAMESPACE uiNamespace
 #endif
 
+/*
+	Define: OOP_SERIALIZE
+	Needed by <SERIALIZE> and <DESERIALIZE> in the default switch dispatcher, where the variable list
+	is collected by probing every <VARIABLE> case of the class. Without it, calls skip that probe test.
+	<OOP_TABLE_DISPATCH> collects the variable list at class definition and does not need it.
+*/
+
+/*
+	Defines:
+	- OOP_REPLICATION
+		Enables the network replication of <REPLICATED_VARIABLE> members. The first class definition
+		installs the "OOP_fnc_replicationApply" and "OOP_fnc_replicationRequest" remote functions on every
+		machine and the periodic flush on the server. Both are compiled final, updates are only applied
+		when sent by the server and state requests are only answered by the server.
+	- OOP_REPLICATION_INTERVAL
+		Time in seconds between two flushes of the dirty replicated variables, default 0.1.
+*/
+#ifndef OOP_REPLICATION_INTERVAL
+#define OOP_REPLICATION_INTERVAL 0.1
+#endif
+
+/*
+	Define: OOP_REMOTE
+	Enables <NEW_REMOTE>. The first class definition installs the "OOP_fnc_remoteNew" and
+	"OOP_fnc_remoteBatch" remote functions on every machine, which must be allowed in CfgRemoteExec,
+	and a per-frame flush of the pending <REMOTE_CALL> packets. Both are compiled final and drop
+	packets not sent by the server, except call batches the server receives from a headless client,
+	so <REMOTE_CALL> only reaches other machines from the server and the headless clients.
+*/
+
+/*
+	Define: OOP_ASYNC_BUDGET
+	Time in seconds the asynchronous scheduler may spend per frame running queued member calls
+	(see <ASYNC_CALL>). At least one queued call runs every frame.
+*/
+#ifndef OOP_ASYNC_BUDGET
+#define OOP_ASYNC_BUDGET 0.002
+#endif
+
+/*
+	Define: OOP_CACHE_SIZE
+	Maximum number of argument values remembered by one <CACHED_FUNCTION> cache. A full cache is
+	emptied before the next lookup.
+*/
+#ifndef OOP_CACHE_SIZE
+#define OOP_CACHE_SIZE 256
+#endif
+
+/*
+	Define: OOP_TABLE_DISPATCH
+	When defined before including oop.h, classes are built in table dispatch mode. Every member declared
+	between <CLASS> and <ENDCLASS> is registered once, at class definition, into a per-class hashmap
+	(stored in <NAMESPACE> as "className_#MT"), and each call resolves its member with a single lookup
+	instead of walking the whole case chain. The class source does not change between both modes.
+	Overloads are keyed on (member, typeName) so a call resolves its overload directly, falling back to
+	the "ANY" overload of the member when no overload declares the argument type.
+	Members inherited through <CLASS_EXTENDS> are resolved once per (member, argument type, access) and
+	cached in "className_#RT", so inherited calls jump straight to the ancestor implementing them.
+	Parent classes must be defined before their children are called, and redefining a parent class
+	requires redefining its children. Member names are matched case-sensitively in table dispatch mode.
+*/
+
+/*
+	Define: OOP_HANDLES
+	When defined before including oop.h, <NEW> returns a lightweight [className, classID] handle instead
+	of compiling a dedicated code object for every instance. Handles are passed to the single shared
+	class dispatcher by <INVOKE> and <DELETE>, and are also what the "this" member holds.
+	The "this" handle is written directly to the instance storage, without type check, so existing
+	PRIVATE VARIABLE("code","this") declarations still read it, but setting it again with MEMBER needs
+	an "ANY" or "ARRAY" declaration.
+	Handles can not be called directly: use <INVOKE> instead of ["memberName", args] call instance.
+*/
+
+/*
+	Define: OOP_HASHMAP_STORAGE
+	When defined before including oop.h, each instance owns one hashmap per namespace (stored under its
+	classID in <NAMESPACE> and <UINAMESPACE>) holding all its member variables, instead of one
+	"classID_varName" namespace entry per variable. <VARIABLE>, <UI_VARIABLE>, <DELETE_VARIABLE> and
+	<MOD_VAR> work unchanged against it. Static calls have no instance storage in this mode.
+	The <UINAMESPACE> hashmap is only created by the first UI variable write of the instance.
+*/
+
+/*
+	Define: OOP_CLASS_STORAGE
+	When defined before including oop.h, each root class gets its own location namespace (stored in
+	<NAMESPACE> as "className_#STORE") holding the instance variables, static variables and ID counters
+	of its whole hierarchy, instead of writing them all to <NAMESPACE>. Classes built with
+	<CLASS_EXTENDS> share the container of their root class, so parent classes must be defined first.
+	UI variables stay in <UINAMESPACE>. See <CLEAR_CLASS_STORAGE>.
+*/
+
+/*
+	Define: OOP_RELEASE
+	When defined before including oop.h, <FUNCTION> and <VARIABLE> members are matched by name only and
+	the argument type is never checked. Only use it for tested code which does not overload a member
+	name with several types, as the first declared overload always wins.
+*/
+
+/*
+	Define: OOP_PROFILE
+	When defined before including oop.h, every dispatched call records its call count, cumulative and
+	max time per className and member, and instance creations are counted under the "#new" member
+	(deletions under "#delete"). Times include the nested calls made by the member.
+	Without this define the profiler adds no code at all. See <PROFILE_REPORT>.
+*/
+
+/*
+	Defines:
+	- OOP_AUTO_CLEANUP
+		Tracks every member variable an instance writes to <NAMESPACE> and <UINAMESPACE>, and nils them
+		all after the deconstructor when the instance is deleted with <DELETE>. Storage created with
+		<OOP_HASHMAP_STORAGE> is always released on <DELETE> and does not need tracking.
+	- OOP_REGISTRY
+		Keeps the live instances of each class in a "className_#REG" hashmap of classID to instance,
+		updated in constant time on creation, <DELETE> and pool release.
+		See <COUNT_INSTANCES> and <FOREACH_INSTANCE>.
+	- OOP_DELETE_DEFERRED
+		Enables <DELETE_DEFERRED>. Every public call then checks first whether its instance is pending
+		a deferred deletion, the classIDs deleted this way being marked in "OOP_DEAD" (see
+		<DELETE_DEFERRED> for when the mark is dropped).
+	- OOP_RECYCLE_IDS
+		Pushes the classID of deleted instances in "className_#IDFREE" and hands them back to the next
+		<NEW> instead of growing "className_IDAI". Old references to a deleted instance then address
+		the new one, so only enable it when deleted instances are never called again.
+		A recycled classID must not inherit the variables of its previous instance, so this define
+		turns on OOP_AUTO_CLEANUP unless <OOP_HASHMAP_STORAGE> is defined.
+*/
+
 /*
 	Macro: CLASS(className)
 	Initializes a new class, or overwrites an existing one.
@@ -104,7 +1138,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 	See Also:
 		<CLASSEXTENDS>
 */
-#define CLASS(className) INSTANTIATE_CLASS(className) default {nil};
+#define CLASS(className) INSTANTIATE_CLASS(className,"")
 
 /*
 	Macro: CLASS_EXTENDS(childClassName,parentClassName)
@@ -120,7 +1154,23 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 	See Also:
 		<CLASS>
 */
-#define CLASS_EXTENDS(childClassName,parentClassName) INSTANTIATE_CLASS(childClassName) default {CALLCLASS(parentClassName,_member,_this,1);};
+#define CLASS_EXTENDS(childClassName,parentClassName) INSTANTIATE_CLASS(childClassName,parentClassName)
+
+/*
+	Macros:
+		FINAL_CLASS(className)
+		FINAL_CLASS_EXTENDS(childClassName,parentClassName)
+	
+	Description:
+		Same as <CLASS> and <CLASS_EXTENDS>, but the class code is compiled final once at definition, so
+		it can not be overwritten afterwards. Use instead of calling "protected" after <ENDCLASS>, which
+		recompiles the whole class a second time.
+		With <OOP_TABLE_DISPATCH> only the dispatcher is final: it still reads the member table,
+		resolve cache and parent link from writable <NAMESPACE> variables at every call, so table mode
+		does not lock the member code against code able to rewrite them.
+*/
+#define FINAL_CLASS(className) INSTANTIATE_FINAL_CLASS(className,"")
+#define FINAL_CLASS_EXTENDS(childClassName,parentClassName) INSTANTIATE_FINAL_CLASS(childClassName,parentClassName)
 
 /*
 	Defines:
@@ -149,7 +1199,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 	See Also:
 		<VARIABLE>
 */
-#define FUNCTION(typeStr,fncName) {CHECK_MEMBER(fncName)} && {CHECK_TYPE(typeStr)}):
+#define FUNCTION(typeStr,fncName) DECLARE_FUNCTION(typeStr,fncName)
 
 /*
 	Macros: 
@@ -166,10 +1216,48 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 	See Also:
 		<FUNCTION>
 */
-#define VARIABLE(typeStr,varName) CHECK_VAR(typeStr,varName)): VAR_DFT_FUNC(varName)
-#define UI_VARIABLE(typeStr,varName) CHECK_VAR(typeStr,varName)): UIVAR_DFT_FUNC(varName)
-#define STATIC_VARIABLE(typeStr,varName) CHECK_VAR(typeStr,varName)): SVAR_DFT_FUNC(varName)
-#define STATIC_UI_VARIABLE(typeStr,varName) CHECK_VAR(typeStr,varName)): SUIVAR_DFT_FUNC(varName)
+#define VARIABLE(typeStr,varName) DECLARE_INSTANCE_VARIABLE(typeStr,varName) VAR_DFT_FUNC(varName)
+#define UI_VARIABLE(typeStr,varName) DECLARE_VARIABLE(typeStr,varName) UIVAR_DFT_FUNC(varName)
+#define STATIC_VARIABLE(typeStr,varName) DECLARE_STATIC_VARIABLE(typeStr,varName) SVAR_DFT_FUNC(varName)
+#define STATIC_UI_VARIABLE(typeStr,varName) DECLARE_STATIC_UI_VARIABLE(typeStr,varName) SUIVAR_DFT_FUNC(varName)
+
+/*
+	Macro: REPLICATED_VARIABLE(typeStr,varName)
+	Initializes a new variable member of a class which is replicated to clients when <OOP_REPLICATION>
+	is defined, and behaves as a <VARIABLE> otherwise. Writes done on the server mark the variable dirty;
+	every <OOP_REPLICATION_INTERVAL> the server sends all dirty variables of all instances in a single
+	packet to the clients, and JIP clients receive the whole replicated state once on join.
+	Writes through <MEMBER>, <SET_VAR> and the <MOD_VAR_DIRECT> macros are tracked, the last two only from
+	a member of the declaring class or of its children. Changing an array got from the variable by
+	reference is not tracked: set it again or use the array macros.
+	Deleting an instance on the server deletes its replicated variables on the clients.
+	
+	Parameters:
+		typeStr - The typeName of the argument. Reference <http://community.bistudio.com/wiki/typeName> [string].
+		varName - The name of the variable member [string].
+*/
+#define REPLICATED_VARIABLE(typeStr,varName) DECLARE_REPLICATED_VARIABLE(typeStr,varName) REPVAR_DFT_FUNC(varName)
+
+/*
+	Macro: LAZY_VARIABLE(typeStr,varName,initCode)
+	Initializes a new variable member of a class whose value is computed by initCode on its first get
+	through MEMBER(varName,nil), then stored as with <VARIABLE>. initCode runs in the instance with
+	_this set to nil and can call other members; a nil result is not stored and is computed again on the
+	next get. Setting the variable first skips initCode. <MOD_VAR>, <PUSH_ARR> and <REM_ARR> read it
+	through MEMBER and so run initCode first. <GET_VAR> and the <MOD_VAR_DIRECT> macros work on the
+	stored value only and never run initCode: before the first get or set they see nil, so read the
+	variable once with MEMBER before using them. initCode containing commas must be enclosed in
+	parentheses.
+	
+	Example:
+		PRIVATE LAZY_VARIABLE("ARRAY","spawnPositions",({[_classID] call fnc_findSpawns}));
+	
+	Parameters:
+		typeStr - The typeName of the argument. Reference <http://community.bistudio.com/wiki/typeName> [string].
+		varName - The name of the variable member [string].
+		initCode - The code computing the initial value [code].
+*/
+#define LAZY_VARIABLE(typeStr,varName,initCode) DECLARE_INSTANCE_VARIABLE(typeStr,varName) LAZYVAR_DFT_FUNC(varName,initCode)
 
 /*
 	Macro: DELETE_VARIABLE(varName)
@@ -206,28 +1294,601 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define NEW(class, args) ["new", args] call class
 
 /*
-	Macro: DELETE(class, instance)
-	Delete the instance of object of class
+	Macro: DELETE(instance)
+	Delete the instance of object of class: its deconstructor is called, then its member variables are
+	released when the storage allows it (see <OOP_HASHMAP_STORAGE> and <OOP_AUTO_CLEANUP>).
+*/
+#define DELETE(instance) CALL_INSTANCE(instance,DELETE_METHOD,nil)
+
+/*
+	Macro: DELETE_DEFERRED(instance)
+	Deletes an instance like <DELETE>, but spreads the work over the next frames. The instance stops
+	answering public calls immediately, leaves the <OOP_REGISTRY> registry and invalidates its weak
+	handles, while its deconstructor and variable cleanup run later from the asynchronous scheduler
+	(see <OOP_ASYNC_BUDGET>), after the pending calls of priority 0 and above. With
+	<OOP_HASHMAP_STORAGE> or <OOP_AUTO_CLEANUP> the instance is then deleted like any other, and its
+	"OOP_DEAD" mark is dropped. With the default storage, which can not tell a deleted instance
+	apart, it keeps ignoring public calls after its cleanup and its mark stays in "OOP_DEAD".
+	Needs <OOP_DELETE_DEFERRED>, without it the instance is deleted right away as with <DELETE>.
+*/
+#define DELETE_DEFERRED(instance) CALL_INSTANCE(instance,DELETE_DEFERRED_METHOD,nil)
+
+/*
+	Macros:
+		NEW_REMOTE(class, args)
+		REMOTE_CALL(remote, memberStr, args)
+		REMOTE_DELETE(remote)
+		REMOTE_LOCAL(remote)
+	
+	Description:
+		NEW_REMOTE creates an instance of class on the machine running the fewest remote instances
+		among the server and the headless clients, when called on the server, and returns a
+		[className, classID, owner] remote handle right away. Called on any other machine, the instance
+		is created locally. REMOTE_CALL calls a public member of a remote instance: on its owner it is a
+		direct call returning the result, otherwise the call is queued and all queued calls to a machine
+		are sent in one packet at the end of the frame, in order, and return nil. REMOTE_DELETE deletes a
+		remote instance. REMOTE_LOCAL tells whether the instance lives on this machine.
+		Remote classIDs are "className_r<machine>n<counter>", machine being the clientOwner of the
+		machine which called NEW_REMOTE, so IDs allocated by different machines never collide.
+		Needs <OOP_REMOTE>. Instances of a headless client which disconnects are lost.
+*/
+#define NEW_REMOTE(class, args) ["newRemote", args] call class
+#define REMOTE_CALL(remote, memberStr, args) (call { \
+	private _oopRemote = remote; \
+	if ((_oopRemote select 2) isEqualTo clientOwner) then { \
+		[_oopRemote select 1, memberStr, args, 0] call GETCLASS(_oopRemote select 0) \
+	} else { \
+		private _packet = [_oopRemote select 0, _oopRemote select 1, memberStr, args]; \
+		REMOTE_PUSH((_oopRemote select 2),_packet); \
+		nil \
+	}; \
+})
+#define REMOTE_DELETE(remote) (call { \
+	private _oopDeleted = remote; \
+	if (isServer) then {GETREMOTELOAD set [_oopDeleted select 2, ((GETREMOTELOAD getOrDefault [_oopDeleted select 2, 1]) - 1) max 0]}; \
+	REMOTE_CALL(_oopDeleted,DELETE_METHOD,nil); \
+})
+#define REMOTE_LOCAL(remote) (((remote) select 2) isEqualTo clientOwner)
+
+/*
+	Macro: INVOKE(instance, memberStr, args)
+	Calls a public member of an instance returned by <NEW>, whatever its kind (code or <OOP_HANDLES> handle).
+	
+	Parameters:
+		instance - The instance returned by <NEW> [code or array].
+		memberStr - The name of the member function or variable [string].
+		args - The arguments to be passed to the member function or variable [any].
+*/
+#define INVOKE(instance, memberStr, args) CALL_INSTANCE(instance,memberStr,args)
+
+/*
+	Macros:
+		SERIALIZE(instance)
+		DESERIALIZE(class, data)
+	
+	Description:
+		SERIALIZE returns a compact snapshot of all <VARIABLE> and <REPLICATED_VARIABLE> members of an
+		instance, including the ones declared by its <CLASS_EXTENDS> parents, as
+		[[format, schemaVersion], [value1, value2, ...]], values being ordered as the variables are declared
+		(child class first). schemaVersion is the result of the optional "schemaVersion" member.
+		DESERIALIZE creates a new instance of class from such a snapshot without calling its constructor,
+		then calls its optional "restored" member with the schemaVersion of the snapshot.
+		Add new variables after the existing ones to keep old snapshots loadable.
+		Static and UI variables are not part of the snapshot.
+		Without <OOP_TABLE_DISPATCH>, both need <OOP_SERIALIZE> to collect the variable list.
+*/
+#define SERIALIZE(instance) CALL_INSTANCE(instance,SERIALIZE_METHOD,nil)
+#define DESERIALIZE(class, data) ["deserialize", data] call class
+
+/*
+	Macro: NEW_ARRAY(class, count, argsArray)
+	Instanciates count new objects of class and returns them in an array. Their IDs are reserved in
+	one step, then the constructor of the object at index i is called with argsArray select i
+	(nil when argsArray is shorter than count). Pass argsArray as a variable, not as a literal array.
+*/
+#define NEW_ARRAY(class, count, argsArray) ["newArray", [count, argsArray]] call class
+
+/*
+	Macro: NEW_POOLED(class, args)
+	Returns an instance of class taken from its pool, or a new one when the pool is empty.
+	The constructor is called with args in both cases, but a pooled instance keeps its classID and
+	storage, so no ID allocation or instance creation happens on a pool hit.
 */
-#define DELETE(instance) "deconstructor" call instance
+#define NEW_POOLED(class, args) ["newPooled", args] call class
+
+/*
+	Macros:
+		RETAIN(instance)
+		RELEASE(instance)
+	
+	Description:
+		Every instance starts with one reference. RETAIN adds one and returns the new count. RELEASE
+		removes one and returns the remaining count while it is above zero. On the last release, an
+		instance obtained with <NEW_POOLED> goes back to the pool of its class, and its optional "reset"
+		member (any access) is called with no argument to restore its state. Any other instance is
+		deleted as with <DELETE>.
+*/
+#define RETAIN(instance) CALL_INSTANCE(instance,RETAIN_METHOD,nil)
+#define RELEASE(instance) CALL_INSTANCE(instance,RELEASE_METHOD,nil)
+
+/*
+	Macros:
+		WEAK(instance)
+		WEAK_VALID(weak)
+		WEAK_GET(weak)
+	
+	Description:
+		WEAK returns a weak handle to instance, which does not count as a reference. WEAK_VALID tells
+		with a single hashmap lookup, without calling the class, whether the instance is still alive.
+		It turns false once the instance is deleted, released back to its pool, or its classID is
+		recycled. WEAK_GET returns the instance, or nil when the handle is no longer valid.
+*/
+#define WEAK(instance) CALL_INSTANCE(instance,WEAK_METHOD,nil)
+#define WEAK_VALID(weak) ((GETWEAKS getOrDefault [(weak) select 1, -1]) isEqualTo ((weak) select 2))
+#define WEAK_GET(weak) (if (WEAK_VALID(weak)) then {(weak) select 0} else {nil})
+
+/*
+	Macro: POOL_STATS(class)
+	Returns the pool statistics of class as [hits, misses, high-water mark, current size].
+*/
+#define POOL_STATS(class) ["poolStats"] call class
+
+/*
+	Macros:
+		COUNT_INSTANCES(class)
+		FOREACH_INSTANCE(class, code)
+	
+	Description:
+		COUNT_INSTANCES returns the number of live instances of class, not counting instances of its
+		child classes. FOREACH_INSTANCE runs code for each of them without copying the registry, with _x
+		set to the classID and _instance to the instance. Do not create or delete instances of class
+		inside code: collect them first. Both need <OOP_REGISTRY>, and see no instance without it.
+		code containing commas must be passed as a variable.
+*/
+#define COUNT_INSTANCES(class) (count (["registry"] call class))
+#define FOREACH_INSTANCE(class,code) (call {private _oopEach = code; {private _instance = _y; call _oopEach} forEach (["registry"] call class)})
+
+/*
+	Macro: CLEAR_CLASS_STORAGE(className)
+	Drops every instance variable and static variable of className and of all the classes sharing its
+	container in one pass, without calling any deconstructor. ID counters are kept so classIDs are
+	never handed out twice, and the dropped instances leave the registry and the pools, their weak
+	handles turn invalid and their event subscriptions are removed.
+	Does nothing without <OOP_CLASS_STORAGE>.
+	
+	Parameters:
+		className - The name of the class [string].
+*/
+#ifdef OOP_CLASS_STORAGE
+#define CLEAR_CLASS_STORAGE(className) (call { \
+	private _oopStore = GETCLASSSTORE(className); \
+	if !(isNil "_oopStore") then { \
+		private _oopCleared = (keys GETCLASSES) select {GETCLASSSTORE(_x) isEqualTo _oopStore}; \
+		private _oopKeep = []; \
+		{ \
+			_oopKeep append [toLower AUTO_INC_VAR(_x), toLower FREE_IDS_VAR(_x)]; \
+			if !(isNil {NAMESPACE getVariable REGISTRY_VAR(_x)}) then {NAMESPACE setVariable [REGISTRY_VAR(_x), createHashMap]}; \
+			NAMESPACE setVariable [POOL_VAR(_x), createHashMap]; \
+			NAMESPACE setVariable [POOL_FREE_VAR(_x), []]; \
+		} forEach _oopCleared; \
+		{ \
+			private _classID = _x; \
+			if (CLASS_OF_ID(_classID) in _oopCleared) then {WEAK_FORGET; EVENTS_FORGET; DEAD_FORGET}; \
+		} forEach ((keys GETWEAKS) + (keys GETEVENTS) + (keys GETEVENTSUBS) + (keys (NAMESPACE getVariable [DEAD_VAR, createHashMap]))); \
+		{if !((toLower _x) in _oopKeep) then {_oopStore setVariable [_x, nil]}} forEach (allVariables _oopStore); \
+	}; \
+})
+#else
+#define CLEAR_CLASS_STORAGE(className)
+#endif
 
 /*
 	Macro: STATIC_FUNCTION(class, fncName, args)
-	Call a static function name of class with args
+	Call a static function name of class with args, in a single dispatch of class.
+*/
+#define STATIC_FUNCTION(instance, fncName, args) ([nil, fncName, args, 0] call instance)
+
+/*
+	Macros:
+		PROFILE_REPORT
+		PROFILE_RESET
+	
+	Description:
+		Dumps to RPT the <OOP_PROFILE> results of all classes, sorted by cumulative time, one
+		"OOP_PROFILE,className,member,calls,totalMs,maxMs" line per member, and returns them as
+		[[totalTime, className, member, calls, maxTime], ...]. ["profile"] call ClassName does the same
+		for a single class. PROFILE_RESET clears all results.
 */
-#define STATIC_FUNCTION(instance, fncName, args) ["static", [fncName, args]] call instance
+#define PROFILE_REPORT ([] call {PROFILE_DUMP("")})
+#define PROFILE_RESET (if !(isNil {GETPROFILE}) then {NAMESPACE setVariable [PROFILE_VAR, createHashMap]})
 
 /*
-	Macro: FUNC_GETVAR(varName)
-	Returns a variable of the current class, used as a function.
+	Macros:
+		MEMORY_REPORT(className)
+		MEMORY_SNAPSHOT
+		MEMORY_DIFF(before, after)
+	
+	Description:
+		MEMORY_REPORT returns, and dumps to RPT as one "OOP_MEMORY,..." line, the state held by className as
+		[className, instances, variables, uiVariables, bytes, highWater]. instances counts the live
+		instances (from <OOP_REGISTRY> when defined, otherwise the instances holding at least one
+		variable), variables and uiVariables the member and static variables stored in <NAMESPACE> and
+		<UINAMESPACE>, bytes the approximate serialized size of their values, and highWater the
+		"className_IDAI" counter. Framework bookkeeping (reference counts, instance caches and the
+		<OOP_AUTO_CLEANUP> tracking maps) is not counted, nor are the variables of the classes whose
+		name starts with "className_".
+		MEMORY_SNAPSHOT returns a hashmap of the reports of all defined classes, without dumping them.
+		MEMORY_DIFF compares two snapshots, and returns and dumps as "OOP_LEAK,..." lines the classes
+		which grew, as [className, instances, variables, uiVariables, bytes] deltas sorted by bytes.
+		Scanning walks every variable of both namespaces, so do not call these every frame.
+	
+	Example:
+		private _before = MEMORY_SNAPSHOT;
+		...
+		MEMORY_DIFF(_before, MEMORY_SNAPSHOT);
+*/
+#define MEMORY_REPORT(className) (call {MEMORY_CLASS(className); MEMORY_LINE("OOP_MEMORY,",_stats); _stats})
+#define MEMORY_SNAPSHOT (call {private _snapshot = createHashMap; {_snapshot set [_x, call {MEMORY_CLASS(_x)}]} forEach (keys GETCLASSES); _snapshot})
+#define MEMORY_DIFF(before, after) (call { \
+	private _memBefore = before; \
+	private _memAfter = after; \
+	private _leaks = []; \
+	{ \
+		private _old = _memBefore getOrDefault [_x, [_x, 0, 0, 0, 0, 0]]; \
+		private _delta = [_x]; \
+		for "_index" from 1 to 4 do {_delta pushBack ((_y select _index) - (_old select _index))}; \
+		if (((_delta select 1) > 0) || {(_delta select 2) > 0} || {(_delta select 3) > 0}) then {_leaks pushBack [_delta select 4, _delta]}; \
+	} forEach _memAfter; \
+	_leaks sort false; \
+	_leaks = _leaks apply {_x select 1}; \
+	{MEMORY_LINE("OOP_LEAK,",_x)} forEach _leaks; \
+	_leaks \
+})
+
+/*
+	Macros:
+		GET_VAR(varName)
+		SET_VAR(varName,value)
+		GET_UI_VAR(varName)
+		SET_UI_VAR(varName,value)
+	
+	Description:
+		Reads or writes a <VARIABLE> (or <UI_VARIABLE>) of the current instance directly in its storage,
+		without going through the class dispatcher. These macros must be used inside a member function.
+		Outside of <OOP_RELEASE> builds, SET_VAR logs to RPT a value whose type differs from the stored one.
+		SET_VAR and SET_UI_VAR are statements and can not be used as an expression.
+	
+	Parameters:
+		varName - The name of the variable member [string].
+		value - The new value of the variable [any].
+*/
+#define GET_VAR(varName) STORE_GET(DATA_NAMESPACE,varName)
+#define SET_VAR(varName,value) VAR_SET_DIRECT(DATA_NAMESPACE,varName,value); REPLICATION_TOUCH(varName)
+#define GET_UI_VAR(varName) UISTORE_GET(varName)
+#define SET_UI_VAR(varName,value) STORE_ENSURE(UINAMESPACE); VAR_SET_DIRECT(UINAMESPACE,varName,value)
+
+/*
+	Macros:
+		MOD_VAR(varName,mod)
+		INC_VAR(varName)
+		DEC_VAR(varName)
+		PUSH_ARR(varName,array)
+		REM_ARR(varName,array)
+	
+	Description:
+		Modifies a member variable of the current instance through <MEMBER>, so they work on any variable
+		or accessor member. MOD_VAR adds mod to the variable, INC_VAR and DEC_VAR add 1 and -1, PUSH_ARR
+		appends all elements of array and REM_ARR removes every element equal to one of array. The array
+		macros build a new array, see <MOD_VAR_DIRECT> for in place variants.
+		These macros must be used inside a member function.
+	
+	Parameters:
+		varName - The name of the variable member [string].
+*/
+#define MOD_VAR(varName,mod) MEMBER(varName,MEMBER(varName,nil)+mod);
+#define INC_VAR(varName) MOD_VAR(varName,1)
+#define DEC_VAR(varName) MOD_VAR(varName,-1)
+#define PUSH_ARR(varName,array) MOD_VAR(varName,array)
+#define REM_ARR(varName,array) MEMBER(varName,MEMBER(varName,nil)-(array));
+
+/*
+	Macros:
+		MOD_VAR_DIRECT(varName,mod)
+		INC_VAR_DIRECT(varName)
+		DEC_VAR_DIRECT(varName)
+		PUSH_ARR_DIRECT(varName,array)
+		PUSHBACK_ARR_DIRECT(varName,element)
+		REM_ARR_DIRECT(varName,array)
+		DELETEAT_ARR_DIRECT(varName,index)
+	
+	Description:
+		Modifies a <VARIABLE> of the current instance in its storage, resolving it only once and without
+		going through the class dispatcher. Like <GET_VAR> and <SET_VAR>, they only work on instance
+		variables: use <MOD_VAR> and its siblings for UI and static variables and for accessor members.
+		These macros must be used inside a member function.
+		MOD_VAR_DIRECT adds mod to the variable, INC_VAR_DIRECT and DEC_VAR_DIRECT add 1 and -1.
+		The array macros mutate the stored array in place: PUSH_ARR_DIRECT appends all elements of array,
+		PUSHBACK_ARR_DIRECT appends element and returns its index, REM_ARR_DIRECT removes every element
+		equal to one of array, DELETEAT_ARR_DIRECT removes and returns the element at index.
+	
+	Parameters:
+		varName - The name of the variable member [string].
+*/
+#define MOD_VAR_DIRECT(varName,mod) STORE_SET(DATA_NAMESPACE,varName,(STORE_GET(DATA_NAMESPACE,varName) + (mod))); REPLICATION_TOUCH(varName);
+#define INC_VAR_DIRECT(varName) MOD_VAR_DIRECT(varName,1)
+#define DEC_VAR_DIRECT(varName) MOD_VAR_DIRECT(varName,-1)
+#define PUSH_ARR_DIRECT(varName,array) VAR_TOUCHED(varName,(STORE_GET(DATA_NAMESPACE,varName) append (array)))
+#define PUSHBACK_ARR_DIRECT(varName,element) VAR_TOUCHED(varName,(STORE_GET(DATA_NAMESPACE,varName) pushBack (element)))
+#define REM_ARR_DIRECT(varName,array) (call { \
+	private _varArray = STORE_GET(DATA_NAMESPACE,varName); \
+	private _varRemove = array; \
+	for "_varIndex" from ((count _varArray) - 1) to 0 step -1 do { \
+		if ((_varArray select _varIndex) in _varRemove) then {_varArray deleteAt _varIndex}; \
+	}; \
+	REPLICATION_TOUCH(varName); \
+})
+#define DELETEAT_ARR_DIRECT(varName,index) VAR_TOUCHED(varName,(STORE_GET(DATA_NAMESPACE,varName) deleteAt (index)))
+
+/*
+	Macros:
+		ASYNC_CALL(instance, memberStr, args)
+		ASYNC_CALL_PRIORITY(instance, memberStr, args, priority, callback)
+		ASYNC_MEMBER(memberStr, args)
+		ASYNC_MEMBER_PRIORITY(memberStr, args, priority, callback)
+	
+	Description:
+		Queues a member call in the framework job queue instead of running it now. Queued calls run from an
+		EachFrame mission event handler, highest priority first then in queue order, within the
+		<OOP_ASYNC_BUDGET> time budget per frame. ASYNC_CALL calls a public member of an instance like
+		<INVOKE>, ASYNC_MEMBER calls a member of the current class like <MEMBER> and must be used inside
+		a member function. In both cases access rules apply as for a direct call.
+		When given, callback is called with [instance, result] once the call is done, instance being
+		[className, classID] for ASYNC_MEMBER. These macros are statements.
+	
+	Parameters:
+		instance - The instance returned by <NEW> [code or array].
+		memberStr - The name of the member function or variable [string].
+		args - The arguments to be passed to the member function or variable [any].
+		priority - Higher priorities run first, default 0 [scalar].
+		callback - Code called when the call is done, or nil [code].
+*/
+#define ASYNC_CALL(instance, memberStr, args) ASYNC_PUSH(0,false,instance,memberStr,args,nil)
+#define ASYNC_CALL_PRIORITY(instance, memberStr, args, priority, callback) ASYNC_PUSH(priority,false,instance,memberStr,args,callback)
+#define ASYNC_MEMBER(memberStr, args) ASYNC_PUSH(0,true,(+[_class, _classID]),memberStr,args,nil)
+#define ASYNC_MEMBER_PRIORITY(memberStr, args, priority, callback) ASYNC_PUSH(priority,true,(+[_class, _classID]),memberStr,args,callback)
+
+/*
+	Macro: ASYNC_PENDING
+	Returns the number of member calls waiting in the asynchronous scheduler queue.
+*/
+#define ASYNC_PENDING (count (NAMESPACE getVariable [ASYNC_QUEUE_VAR, []]))
+
+/*
+	Macros:
+		CACHED_FUNCTION(typeStr, fncName)
+		CACHED_INSTANCE_FUNCTION(typeStr, fncName)
+		INVALIDATE_CACHE(fncName)
+		INVALIDATE_INSTANCE_CACHE(fncName)
+	
+	Description:
+		Drop-in replacements for <FUNCTION> memoizing the non-nil results of a pure function, keyed on its
+		argument. CACHED_FUNCTION shares one cache per class across all its instances, and
+		CACHED_INSTANCE_FUNCTION keeps one cache per instance in its storage. Arguments must be usable as
+		hashmap keys, and cached arrays are returned by reference so must not be modified.
+		INVALIDATE_CACHE and INVALIDATE_INSTANCE_CACHE empty the cache of fncName from a member of the
+		class declaring it. See <OOP_CACHE_SIZE>.
+	
+	Example:
+		PUBLIC CACHED_FUNCTION("STRING","factionSide") {
+			getNumber (configFile >> "CfgFactionClasses" >> _this >> "side")
+		};
+*/
+#define CACHED_FUNCTION(typeStr,fncName) DECLARE_CACHED_FUNCTION(typeStr,fncName)
+#define CACHED_INSTANCE_FUNCTION(typeStr,fncName) DECLARE_CACHED_INSTANCE_FUNCTION(typeStr,fncName)
+#define INVALIDATE_CACHE(fncName) (GETMEMO(_class) deleteAt (fncName))
+#define INVALIDATE_INSTANCE_CACHE(fncName) STORE_DELETE(DATA_NAMESPACE,MEMO_INSTANCE_VAR(fncName))
+
+/*
+	Macro: SUPER(member,args)
+	Calls the implementation of member in the parent class of the class declaring the current member,
+	with protected access and the current instance, skipping the case chain of the current class.
+	Returns nil when the class has no parent.
+	
+	Example:
+		PUBLIC FUNCTION("","update") {
+			SUPER("update",nil);
+			MEMBER("refresh",nil);
+		};
+	
+	Parameters:
+		member - The name of the parent member [string].
+		args - The arguments of the call [any].
+*/
+#define SUPER(member,args) CALLCLASS(GETPARENT(_class),member,args,1)
+
+/*
+	Macros:
+		EVENT(eventName)
+		SUBSCRIBE(instance, eventName, code)
+		UNSUBSCRIBE(instance, eventName)
+		EMIT(eventName, args)
+	
+	Description:
+		EVENT declares an event member of a class, with the access level preceding it. From a member of
+		another instance, SUBSCRIBE registers code to run each time instance emits eventName, replacing
+		any previous subscription of the same instance, and UNSUBSCRIBE removes it. EMIT, from a member
+		of the emitting instance, runs the code of every subscriber with _this set to args, without any
+		dispatch: code runs as if in a member of the subscriber, so <MEMBER> and <GET_VAR> address the
+		subscriber. Subscriptions of an instance and to its events are dropped on <DELETE>.
+		code containing commas must be passed as a variable.
+	
+	Example:
+		PUBLIC EVENT("changed");
+		...
+		EMIT("changed", _value);
+		...
+		private _onChanged = {MEMBER("refresh", _this)};
+		SUBSCRIBE(_sector, "changed", _onChanged);
+*/
+#define EVENT(eventName) DECLARE_FUNCTION("",eventName) {[_classID, eventName]}
+#define SUBSCRIBE(instance, eventName, code) (call {private _oopKey = CALL_INSTANCE(instance,eventName,nil); EVENT_ADD(_oopKey,code)})
+#define UNSUBSCRIBE(instance, eventName) (call {private _oopKey = CALL_INSTANCE(instance,eventName,nil); EVENT_REMOVE(_oopKey)})
+#define EMIT(eventName, args) (call { \
+	private _oopArgs = args; \
+	private _oopSubs = (GETEVENTS getOrDefault [_classID, createHashMap]) get (eventName); \
+	if !(isNil "_oopSubs") then { \
+		{ \
+			private _classID = _x select 0; \
+			private _class = _x select 1; \
+			BIND_STORE(_class); \
+			_oopArgs call (_x select 2); \
+		} forEach (values _oopSubs); \
+	}; \
+})
+
+/*
+	Macros:
+		FUNC_GETVAR(varName)
+		FUNC_GET_VAR_DIRECT(varName)
+	
+	Description:
+		Return a variable of the current class, used as a function. FUNC_GETVAR goes through the
+		dispatcher and works for any variable member. FUNC_GET_VAR_DIRECT reads an instance variable
+		straight from its storage with <GET_VAR>, and can not be used for static or UI variables.
 	
 	Example:
 		PUBLIC FUNCTION("","getSpawnState") FUNC_GETVAR("spawned");
+		PUBLIC FUNCTION("","getSpawnPos") FUNC_GET_VAR_DIRECT("spawnPos");
 	
 	Parameters:
 		varName - The name of the variable member [string].
 */
 #define FUNC_GETVAR(varName) {MEMBER(varName,nil);}
+#define FUNC_GET_VAR_DIRECT(varName) {GET_VAR(varName);}
+
+/*
+	Macros:
+		BULK_CLASS(className)
+		BULK_FIELD(fieldName, default)
+		BULK_FUNCTION(fncName)
+		BULK_ENDCLASS
+	
+	Description:
+		Defines a bulk class, or overwrites an existing one along with all its instances. Bulk instances are
+		plain indices into one column array per field, stored in <NAMESPACE> as "className_#BULK", so
+		creating one costs no namespace variable and no compiled code. Bulk classes have no inheritance,
+		access levels nor type checks. Array defaults must be enclosed in parentheses and are copied for
+		each new instance. Inside a bulk function, _self is the instance index, _this the arguments, and
+		fields are accessed with <BULK_THIS> and <BULK_THIS_SET>.
+	
+	Example:
+		BULK_CLASS("Tracker")
+			BULK_FIELD("pos", ([0,0,0]));
+			BULK_FIELD("speed", 0);
+			BULK_FUNCTION("tick") {
+				BULK_THIS_SET("pos", (BULK_THIS("pos") vectorAdd [0, 0, BULK_THIS("speed") * _this]));
+			};
+		BULK_ENDCLASS;
+		BULK_APPLY("Tracker", "tick", 0.1);
+*/
+#define BULK_CLASS(className) \
+	private _oopBulkName = className; \
+	private _oopBulkFields = createHashMap; \
+	private _oopBulkDefaults = []; \
+	private _oopBulkFunctions = createHashMap; \
+	private _oopBulkEntry = ""; \
+	private _oopBulkCode = {};
+#define BULK_FIELD(fieldName,default) BULK_FLUSH; _oopBulkFields set [fieldName, count _oopBulkDefaults]; _oopBulkDefaults pushBack (default)
+#define BULK_FUNCTION(fncName) BULK_FLUSH; _oopBulkEntry = fncName; _oopBulkCode =
+#define BULK_ENDCLASS BULK_FLUSH; NAMESPACE setVariable [BULK_VAR(_oopBulkName), [_oopBulkFields, _oopBulkDefaults apply {[]}, _oopBulkDefaults, [], [], _oopBulkFunctions]]
+
+/*
+	Macros:
+		BULK_NEW(className)
+		BULK_DELETE(className, index)
+		BULK_COUNT(className)
+	
+	Description:
+		BULK_NEW returns the index of a new bulk instance, reusing the slot of a deleted one if possible,
+		with all fields set to their default. BULK_DELETE frees the slot of an instance.
+		BULK_COUNT returns the number of live instances.
+*/
+#define BULK_NEW(className) (call { \
+	BULK_BIND(className); \
+	private _free = _bulk select BULK_FREE_INDEX; \
+	private _self = if ((count _free) > 0) then {_free deleteAt ((count _free) - 1)} else {count _bulkAlive}; \
+	_bulkAlive set [_self, true]; \
+	{ \
+		(_bulkColumns select _forEachIndex) set [_self, (if (_x isEqualType []) then {+_x} else {_x})]; \
+	} forEach (_bulk select BULK_DEFAULTS_INDEX); \
+	_self \
+})
+#define BULK_DELETE(className,index) (call { \
+	BULK_BIND(className); \
+	private _self = index; \
+	if (_bulkAlive param [_self, false]) then { \
+		_bulkAlive set [_self, false]; \
+		{_x set [_self, nil]} forEach _bulkColumns; \
+		(_bulk select BULK_FREE_INDEX) pushBack _self; \
+	}; \
+})
+#define BULK_COUNT(className) (call {BULK_BIND(className); (count _bulkAlive) - (count (_bulk select BULK_FREE_INDEX))})
+
+/*
+	Macros:
+		BULK_GET(className, index, fieldName)
+		BULK_SET(className, index, fieldName, value)
+		BULK_COLUMN(className, fieldName)
+		BULK_THIS(fieldName)
+		BULK_THIS_SET(fieldName, value)
+	
+	Description:
+		BULK_GET and BULK_SET read and write one field of a bulk instance. BULK_COLUMN returns the whole
+		column array of a field, indexed by instance, for hot loops; slots of deleted instances hold nil.
+		BULK_THIS and BULK_THIS_SET are their counterparts for the current instance inside
+		<BULK_FUNCTION> and <BULK_FOREACH> code.
+*/
+#define BULK_GET(className,index,fieldName) (((GETBULK(className) select BULK_COLUMNS_INDEX) select ((GETBULK(className) select BULK_FIELDS_INDEX) get fieldName)) select (index))
+#define BULK_SET(className,index,fieldName,value) (((GETBULK(className) select BULK_COLUMNS_INDEX) select ((GETBULK(className) select BULK_FIELDS_INDEX) get fieldName)) set [index, value])
+#define BULK_COLUMN(className,fieldName) ((GETBULK(className) select BULK_COLUMNS_INDEX) select ((GETBULK(className) select BULK_FIELDS_INDEX) get fieldName))
+#define BULK_THIS(fieldName) (BULK_CELL(fieldName) select _self)
+#define BULK_THIS_SET(fieldName,value) (BULK_CELL(fieldName) set [_self, value])
+
+/*
+	Macros:
+		BULK_CALL(className, index, fncName, args)
+		BULK_APPLY(className, fncName, args)
+		BULK_APPLY_RANGE(className, fncName, args, fromIndex, rangeCount)
+		BULK_FOREACH(className, code)
+	
+	Description:
+		BULK_CALL calls a bulk function on one instance and returns its result. BULK_APPLY calls it on
+		every live instance, and BULK_APPLY_RANGE on the live instances among rangeCount indices from fromIndex,
+		all in a single loop resolving the function and columns once. BULK_FOREACH runs code for every live
+		instance with _self set to its index; code containing commas must be passed as a variable.
+*/
+#define BULK_CALL(className,index,fncName,args) (call { \
+	BULK_BIND(className); \
+	private _self = index; \
+	(args) call ((_bulk select BULK_FUNCTIONS_INDEX) get fncName) \
+})
+#define BULK_APPLY_RANGE(className,fncName,args,fromIndex,rangeCount) (call { \
+	BULK_BIND(className); \
+	private _bulkCode = (_bulk select BULK_FUNCTIONS_INDEX) get fncName; \
+	private _bulkArgs = args; \
+	private _bulkFrom = (fromIndex) max 0; \
+	for "_self" from _bulkFrom to (((_bulkFrom + (rangeCount)) min (count _bulkAlive)) - 1) do { \
+		if (_bulkAlive select _self) then {_bulkArgs call _bulkCode}; \
+	}; \
+})
+#define BULK_APPLY(className,fncName,args) BULK_APPLY_RANGE(className,fncName,args,0,1e7)
+#define BULK_FOREACH(className,code) (call { \
+	BULK_BIND(className); \
+	private _bulkCode = code; \
+	for "_self" from 0 to ((count _bulkAlive) - 1) do { \
+		if (_bulkAlive select _self) then {call _bulkCode}; \
+	}; \
+})
 
 /*
 	Define: ENDCLASS
@@ -235,42 +1896,128 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #define ENDCLASS FINALIZE_CLASS
 
-#define INSTANTIATE_CLASS(className) \
-	NAMESPACE setVariable [className, { \
+#define CLASS_PROLOGUE(className,parentClassName) \
+	STORAGE_INIT(className,parentClassName); \
+	NAMESPACE setVariable [MEMO_VAR(className), createHashMap]; \
+	NAMESPACE setVariable [PARENT_VAR(className), parentClassName]; \
+	REGISTRY_INIT(className); \
+	CLASS_REGISTER(className,parentClassName); \
+	WEAK_INIT; \
+	DEAD_INIT; \
+	EVENT_INIT; \
+	REMOTE_INIT; \
+	NAMESPACE setVariable [SCHEMA_VAR(className), nil]; \
+	NAMESPACE setVariable [REPNAMES_VAR(className), nil]; \
+	POOL_INIT(className); \
+	PROFILE_INIT; \
+	REPLICATION_INIT
+
+#define CLASS_BUILTINS(className) \
+	case "new": { \
+		ENSURE_INDEX(1,nil); \
+		CREATE_INSTANCE(className,(_this select 1)); \
+		_code; \
+	}; \
+	case "newArray": { \
+		private _count = (_this select 1) select 0; \
+		private _args = (_this select 1) param [1, []]; \
+		private _first = GET_AUTO_INC(className) + 1; \
+		DATA_NAMESPACE setVariable [AUTO_INC_VAR(className), (GET_AUTO_INC(className) + _count)]; \
+		private _instances = []; \
+		for "_index" from 0 to (_count - 1) do { \
+			private _classID = className + "_" + str(_first + _index); \
+			BUILD_INSTANCE(className,(_args param [_index])); \
+			_instances pushBack _code; \
+		}; \
+		_instances; \
+	}; \
+	case "deserialize": { \
+		DESERIALIZE_INSTANCE(className,(_this select 1)); \
+		_code; \
+	}; \
+	case "newPooled": { \
+		ENSURE_INDEX(1,nil); \
+		POOL_ACQUIRE(className,(_this select 1)); \
+		_code; \
+	}; \
+	case "registry": { \
+		GETREGISTRY(className); \
+	}; \
+	case "poolStats": { \
+		(+GETPOOLSTATS(className)) + [count GETPOOLFREE(className)]; \
+	}; \
+	PROFILE_BUILTINS(className) \
+	REMOTE_BUILTINS(className) \
+	case "static":{ \
+		private _args = _this select 1; \
+		[className, _args select 0, _args param [1], 0] call GETCLASS(className); \
+	}; \
+	case "protected":{ \
+		NAMESPACE setVariable [className, compileFinal toString GETCLASS(className)]; \
+	}; \
+	case "delete": { \
+		if ((count _this) == 2) then {_this set [2,nil]}; \
+		CALL_INSTANCE((_this select 1),DELETE_METHOD,(_this select 2)); \
+	};
+
+#ifdef OOP_TABLE_DISPATCH
+#define CLASS_SETUP(className,parentClassName) \
+	private _oopClassName = className; \
+	private _oopTable = createHashMap; \
+	private _oopAccess = 0; \
+	private _oopEntry = []; \
+	private _oopCode = {}; \
+	private _oopSchema = []; \
+	private _oopReplicated = []; \
+	NAMESPACE setVariable [MEMBER_TABLE_VAR(className), _oopTable]; \
+	NAMESPACE setVariable [OWNVARS_VAR(className), _oopSchema]; \
+	NAMESPACE setVariable [OWNREP_VAR(className), _oopReplicated]; \
+	NAMESPACE setVariable [RESOLVE_TABLE_VAR(className), createHashMap]; \
+	CLASS_PROLOGUE(className,parentClassName)
+
+#define CLASS_DISPATCHER(className,parentClassName) \
 	CHECK_THIS; \
 	if ((count _this) > 0) then { \
 		private _class = className; \
+		BIND_STORE(className); \
 		if (isNil {_this select 0}) then {_this set [0,_class]}; \
 		switch (_this select 0) do { \
-		case "new": { \
-			NAMESPACE setVariable [AUTO_INC_VAR(className), (GET_AUTO_INC(className) + 1)]; \
-			private _code = compile format ['CHECK_THIS; ENSURE_INDEX(1,nil); (["%1", (_this select 0), (_this select 1), 0]) call GETCLASS(className);', (className + "_" + str(GET_AUTO_INC(className)))]; \
-			ENSURE_INDEX(1,nil); \
-			private _classID = className + "_" + str(GET_AUTO_INC(className)); \
-			[_classID, "this", SAFE_VAR(_code), 2] call GETCLASS(className); \
-			[CONSTRUCTOR_METHOD, (_this select 1)] call _code; \
-			_code; \
-		}; \
-		case "static":{ \
-			private _code = compile format ['CHECK_THIS; ENSURE_INDEX(1,nil); (["%1", (_this select 0), (_this select 1), 0]) call GETCLASS(className);', className]; \
-			[(_this select 1) select 0, (_this select 1) select 1] call _code; \
-		}; \
-		case "protected":{ \
-			private _array = toArray str (missionNamespace getVariable className); \
-    			_array deleteAt (count _array - 1); \
-    			_array deleteAt (0); \
-    			missionNamespace setVariable[className, (compileFinal toString _array)]; \
+		CLASS_BUILTINS(className) \
+		default { \
+			DISPATCH_PARAMS; \
+			DEAD_GUARD; \
+			private _code = nil; \
+			TABLE_FIND(GETTABLE(className),_access,_code); \
+			PROFILE_BEGIN if (isNil "_code") then { \
+				if (IS_FRAMEWORK_MEMBER) then {FRAMEWORK_MEMBERS(className,parentClassName)} else {TABLE_FALLBACK(className,parentClassName)}; \
+			} else {call _code}; \
+			PROFILE_END \
 		}; \
-		case "delete": { \
-			if ((count _this) == 2) then {_this set [2,nil]}; \
-			[DECONSTRUCTOR_METHOD, (_this select 2)] call (_this select 1); \
 		}; \
+	}
+
+#define INSTANTIATE_CLASS(className,parentClassName) CLASS_SETUP(className,parentClassName); NAMESPACE setVariable [className, {CLASS_DISPATCHER(className,parentClassName)}];
+#define INSTANTIATE_FINAL_CLASS(className,parentClassName) CLASS_SETUP(className,parentClassName); NAMESPACE setVariable [className, compileFinal toString {CLASS_DISPATCHER(className,parentClassName)}];
+
+#define FINALIZE_CLASS TABLE_FLUSH
+#else
+#define CLASS_DISPATCHER(className,parentClassName) \
+	CHECK_THIS; \
+	if ((count _this) > 0) then { \
+		private _class = className; \
+		BIND_STORE(className); \
+		if (isNil {_this select 0}) then {_this set [0,_class]}; \
+		switch (_this select 0) do { \
+		CLASS_BUILTINS(className) \
 		default { \
-			private _classID = _this select 0; \
-			private _member = _this select 1; \
-			private _access = DEFAULT_PARAM(3,0); \
-			_this = DEFAULT_PARAM(2,nil); \
-			private _argType = if (isNil "_this") then {""} else {typeName _this}; \
-			switch (true) do { \
-			
-#define FINALIZE_CLASS };};};};}]
\ No newline at end of file
+			DISPATCH_PARAMS; \
+			DEAD_GUARD; \
+			SCHEMA_PROBE; \
+			PROFILE_BEGIN switch (true) do { \
+			default {if (IS_FRAMEWORK_MEMBER) then {FRAMEWORK_MEMBERS(className,parentClassName)} else {CLASS_FALLBACK(parentClassName)}};
+
+#define INSTANTIATE_CLASS(className,parentClassName) CLASS_PROLOGUE(className,parentClassName); NAMESPACE setVariable [className, {CLASS_DISPATCHER(className,parentClassName)
+#define INSTANTIATE_FINAL_CLASS(className,parentClassName) CLASS_PROLOGUE(className,parentClassName); NAMESPACE setVariable [className, compileFinal toString {CLASS_DISPATCHER(className,parentClassName)
+
+#define FINALIZE_CLASS }; PROFILE_END };};};}]
+#endif
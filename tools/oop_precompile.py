@@ -0,0 +1,359 @@
+#!/usr/bin/env python3
+"""Offline precompiler for class files written against oop.h.
+
+Inlines inherited members: PUBLIC and PROTECTED members of a parent are
+copied after the members of its CLASS_EXTENDS children, so calls to them no
+longer fall through to the parent dispatcher. The output still includes
+oop.h and uses the same macro API, and every call resolves to the same
+overload as in the unprocessed source:
+
+- Members depending on the class they are declared in (MEMBER and the macros
+  built on it, SUPER, _class, SUBSCRIBE and UNSUBSCRIBE, static or cached
+  members) and instance variables, whose declaration order is the SERIALIZE
+  schema, are never copied.
+- A member name is only copied when all its overloads up the parent chain
+  can be copied. An "ANY" overload is only copied when it is the only
+  overload of its name up a parent chain fully defined in the inputs.
+
+Nothing else is done: no flattened member table is emitted, type checks are
+not folded and access checks are not stripped. With OOP_TABLE_DISPATCH the
+resolve cache already turns inherited calls into a single lookup, so the
+output mostly helps the default switch dispatcher.
+
+Classes may be spread over the input files in any order. Comments are not
+kept in the output.
+
+Usage:
+	python3 oop_precompile.py -o outDir classA.sqf classB.sqf ...
+"""
+
+import argparse
+import os
+import re
+import sys
+
+CLASS_MACROS = ("CLASS", "CLASS_EXTENDS", "FINAL_CLASS", "FINAL_CLASS_EXTENDS")
+ACCESS_MACROS = ("PUBLIC", "PROTECTED", "PRIVATE")
+TYPED_MACROS = (
+	"FUNCTION", "VARIABLE", "UI_VARIABLE", "STATIC_VARIABLE", "STATIC_UI_VARIABLE",
+	"REPLICATED_VARIABLE", "LAZY_VARIABLE", "CACHED_FUNCTION", "CACHED_INSTANCE_FUNCTION",
+)
+INSTANCE_VARIABLE_MACROS = ("VARIABLE", "REPLICATED_VARIABLE", "LAZY_VARIABLE")
+CLASS_BOUND = re.compile(r"\b(MEMBER|SUPER|_class|GETSVAR|STATIC_VARIABLE|STATIC_UI_VARIABLE|CACHED_FUNCTION|"
+	r"CACHED_INSTANCE_FUNCTION|INVALIDATE_CACHE|ASYNC_MEMBER|ASYNC_MEMBER_PRIORITY|"
+	r"MOD_VAR|INC_VAR|DEC_VAR|PUSH_ARR|REM_ARR|SUBSCRIBE|UNSUBSCRIBE)\b")
+IDENT = re.compile(r"[A-Za-z_][A-Za-z0-9_]*")
+
+
+def strip_comments(source):
+	"""Removes // and /* */ comments, keeping strings and preprocessor lines intact."""
+	out = []
+	i = 0
+	while i < len(source):
+		c = source[i]
+		if c in "\"'":
+			end = skip_string(source, i)
+			out.append(source[i:end])
+			i = end
+		elif source.startswith("//", i):
+			end = source.find("\n", i)
+			i = len(source) if end < 0 else end
+		elif source.startswith("/*", i):
+			end = source.find("*/", i + 2)
+			i = len(source) if end < 0 else end + 2
+		else:
+			out.append(c)
+			i += 1
+	return "".join(out)
+
+
+def skip_string(source, i):
+	"""Returns the index after the SQF string starting at i; quotes are escaped by doubling."""
+	quote = source[i]
+	i += 1
+	while i < len(source):
+		if source[i] == quote:
+			if source.startswith(quote, i + 1):
+				i += 2
+				continue
+			return i + 1
+		i += 1
+	return i
+
+
+def split_statements(source):
+	"""Splits source on top-level semicolons, outside strings, brackets and preprocessor lines."""
+	statements = []
+	depth = 0
+	start = 0
+	i = 0
+	line_start = True
+	while i < len(source):
+		c = source[i]
+		if line_start and c == "#":
+			end = directive_end(source, i)
+			if depth == 0:
+				statements.append(source[start:i])
+				statements.append(source[i:end])
+				start = end
+			i = end
+			continue
+		if c in "\"'":
+			i = skip_string(source, i)
+			line_start = False
+			continue
+		if c in "([{":
+			depth += 1
+		elif c in ")]}":
+			depth -= 1
+		elif c == ";" and depth == 0:
+			statements.append(source[start:i + 1])
+			start = i + 1
+		if c == "\n":
+			line_start = True
+		elif not c.isspace():
+			line_start = False
+		i += 1
+	statements.append(source[start:])
+	return statements
+
+
+def directive_end(source, i):
+	"""Returns the end of the preprocessor line starting at i, following backslash continuations."""
+	while True:
+		end = source.find("\n", i)
+		if end < 0:
+			return len(source)
+		if not source[i:end].rstrip().endswith("\\"):
+			return end
+		i = end + 1
+
+
+def find_word(text, word):
+	"""Returns the index of word in text outside strings and brackets, or -1."""
+	depth = 0
+	i = 0
+	while i < len(text):
+		c = text[i]
+		if c in "\"'":
+			i = skip_string(text, i)
+			continue
+		match = IDENT.match(text, i)
+		if match:
+			if depth == 0 and match.group(0) == word:
+				return i
+			i = match.end()
+			continue
+		if c in "([{":
+			depth += 1
+		elif c in ")]}":
+			depth -= 1
+		i += 1
+	return -1
+
+
+def parse_call(text, pos):
+	"""Parses NAME(args) at pos, returns (name, [args], end) or None."""
+	match = IDENT.match(text, pos)
+	if not match:
+		return None
+	name = match.group(0)
+	i = match.end()
+	while i < len(text) and text[i] in " \t":
+		i += 1
+	if i >= len(text) or text[i] != "(":
+		return (name, None, match.end())
+	args = []
+	depth = 0
+	start = i + 1
+	while i < len(text):
+		c = text[i]
+		if c in "\"'":
+			i = skip_string(text, i)
+			continue
+		if c in "([{":
+			depth += 1
+		elif c in ")]}":
+			depth -= 1
+			if depth == 0:
+				args.append(text[start:i].strip())
+				return (name, args, i + 1)
+		elif c == "," and depth == 1:
+			args.append(text[start:i].strip())
+			start = i + 1
+		i += 1
+	return None
+
+
+class Member:
+	def __init__(self, text, access, macro, args, body):
+		self.text = text
+		self.access = access
+		self.macro = macro
+		self.args = args
+		self.body = body
+
+	@property
+	def name(self):
+		if self.macro == "EVENT":
+			return self.args[0]
+		return self.args[1] if len(self.args) > 1 else None
+
+	@property
+	def type(self):
+		return self.args[0].upper() if self.macro in TYPED_MACROS else '""'
+
+	def copyable(self):
+		return (self.access in ("PUBLIC", "PROTECTED") and self.macro not in INSTANCE_VARIABLE_MACROS
+			and not CLASS_BOUND.search(self.macro + " " + ",".join(self.args) + " " + self.body))
+
+
+def parse_member(statement):
+	text = statement.strip()
+	stripped = text[:-1].strip() if text.endswith(";") else text
+	access = parse_call(stripped, 0)
+	if not access or access[0] not in ACCESS_MACROS:
+		return None
+	pos = access[2]
+	while pos < len(stripped) and stripped[pos].isspace():
+		pos += 1
+	decl = parse_call(stripped, pos)
+	if not decl or decl[1] is None:
+		return None
+	member = Member(stripped + ";", access[0], decl[0], decl[1], stripped[decl[2]:].strip())
+	return member if member.name is not None else None
+
+
+class ClassDef:
+	def __init__(self, name, parent, macro):
+		self.name = name
+		self.parent = parent
+		self.macro = macro
+		self.items = []
+		self.inherited = []
+
+	def declared(self):
+		return [item for item in self.items if isinstance(item, Member)]
+
+
+def parse_file(source):
+	"""Returns the file as a list of raw statements and ClassDef objects."""
+	parts = []
+	current = None
+	for statement in split_statements(strip_comments(source)):
+		text = statement.strip()
+		if not text:
+			continue
+		call = parse_call(text, 0)
+		if call and call[0] in CLASS_MACROS and call[1]:
+			current = ClassDef(call[1][0], call[1][1] if len(call[1]) > 1 else None, call[0])
+			parts.append(current)
+			rest = text[call[2]:].strip()
+			if rest and rest != ";":
+				text = rest
+			else:
+				continue
+		if current is None:
+			parts.append(text)
+			continue
+		end = -1 if text.startswith("#") else find_word(text, "ENDCLASS")
+		if end >= 0:
+			before = text[:end].strip()
+			if before:
+				current.items.append(parse_member(before) or before)
+			current = None
+			rest = text[end + len("ENDCLASS"):].strip()
+			if rest and rest != ";":
+				parts.append(rest)
+			continue
+		member = parse_member(text)
+		current.items.append(member if member else text)
+	return parts
+
+
+def chain_of(cls, classes):
+	"""Returns the ancestors of cls nearest first, and whether they are all defined in the inputs."""
+	chain = []
+	parent = cls.parent
+	while parent is not None:
+		ancestor = classes.get(parent)
+		if ancestor is None or ancestor in chain:
+			return chain, False
+		chain.append(ancestor)
+		parent = ancestor.parent
+	return chain, True
+
+
+def flatten(classes):
+	"""Copies into each child the inherited overloads which resolve the same way once copied."""
+	for cls in classes.values():
+		chain, complete = chain_of(cls, classes)
+		own = {}
+		for member in cls.declared():
+			own.setdefault(member.name, set()).add(member.type)
+		overloads = {}
+		for ancestor in chain:
+			for member in ancestor.declared():
+				overloads.setdefault(member.name, []).append(member)
+		for name, members in overloads.items():
+			types = {member.type for member in members}
+			if '"ANY"' in own.get(name, ()):
+				continue
+			if not all(member.copyable() for member in members):
+				continue
+			if '"ANY"' in types and (len(types) > 1 or not complete):
+				continue
+			copied = set(own.get(name, ()))
+			for member in members:
+				if member.type not in copied:
+					cls.inherited.append(member)
+					copied.add(member.type)
+
+
+def emit(parts):
+	lines = []
+	for part in parts:
+		if isinstance(part, ClassDef):
+			args = part.name if part.parent is None else "%s,%s" % (part.name, part.parent)
+			lines.append("%s(%s)" % (part.macro, args))
+			for item in part.items:
+				lines.append("\t" + (item.text if isinstance(item, Member) else item))
+			for member in part.inherited:
+				lines.append("\t" + member.text)
+			lines.append("ENDCLASS;")
+		else:
+			lines.append(part)
+	return "\n".join(lines) + "\n"
+
+
+def main(argv):
+	parser = argparse.ArgumentParser(description="Flattens oop.h class files.")
+	parser.add_argument("-o", "--output", required=True, help="output directory")
+	parser.add_argument("files", nargs="+", help="class files")
+	options = parser.parse_args(argv)
+
+	parsed = []
+	classes = {}
+	for path in options.files:
+		with open(path, encoding="utf-8") as handle:
+			parts = parse_file(handle.read())
+		parsed.append((path, parts))
+		for part in parts:
+			if isinstance(part, ClassDef):
+				classes[part.name] = part
+
+	flatten(classes)
+
+	os.makedirs(options.output, exist_ok=True)
+	for path, parts in parsed:
+		target = os.path.join(options.output, os.path.basename(path))
+		with open(target, "w", encoding="utf-8") as handle:
+			handle.write(emit(parts))
+	for cls in classes.values():
+		if cls.inherited:
+			sys.stderr.write("%s: inlined %d inherited member(s)\n" % (cls.name.strip("\"'"), len(cls.inherited)))
+	return 0
+
+
+if __name__ == "__main__":
+	sys.exit(main(sys.argv[1:]))